@@ -45,9 +45,12 @@ RM := rm -v -f
 PYTHON3 := PYTHONPATH="$(TOPDIR)/tools/pylib:$$PYTHONPATH" python3
 FSUTIL := $(TOPDIR)/tools/fsutil.py
 BINPATCH := $(TOPDIR)/tools/binpatch.py
+CHUNKPACK := $(PYTHON3) $(TOPDIR)/tools/chunkpack.py
 LAUNCH := $(PYTHON3) $(TOPDIR)/tools/launch.py
 LWO2C := $(TOPDIR)/tools/lwo2c.py $(QUIET)
+LZ4PACK := $(PYTHON3) $(TOPDIR)/tools/lz4pack.py
 CONV2D := $(TOPDIR)/tools/conv2d.py
+COP2C := $(TOPDIR)/tools/cop2c.py
 GRADIENT := $(TOPDIR)/tools/gradient.py
 TMXCONV := $(TOPDIR)/tools/tmxconv/tmxconv
 PCHG2C := $(TOPDIR)/tools/pchg2c/pchg2c
@@ -64,6 +64,10 @@ data/%.c: data/%.png
 	@echo "[PNG] $(DIR)$< -> $(DIR)$@"
 	$(PNG2C) $(PNG2C.$*) $< > $@
 
+data/%.c: data/%.cop
+	@echo "[COP] $(DIR)$< -> $(DIR)$@"
+	$(COP2C) $(COP2C.$*) $< > $@
+
 data/%.c: data/%.2d
 	@echo "[2D] $(DIR)$< -> $(DIR)$@"
 	$(CONV2D) $(CONV2D.$*) $< > $@
@@ -72,9 +76,18 @@ data/%.c: data/%.sync
 	@echo "[SYNC] $(DIR)$< -> $(DIR)$@"
 	$(SYNC2C) $(SYNC2C.$*) $< > $@
 
-%.adf: %.exe $(DATA) $(DATA_GEN) $(BOOTLOADER)
+data/%.lz4: data/%
+	@echo "[LZ4] $(DIR)$< -> $(DIR)$@"
+	$(LZ4PACK) $(LZ4PACK.$*) $< $@
+
+# Files are laid out on disk in order they're loaded in, if it is known.
+# A log of a run with "[FileSys] Open" lines can serve as the manifest.
+LOADORDER ?= $(wildcard $(EFFECT).order)
+
+%.adf: %.exe $(DATA) $(DATA_GEN) $(BOOTLOADER) $(LOADORDER)
 	@echo "[ADF] $(addprefix $(DIR),$*.exe $(DATA) $(DATA_GEN)) -> $(DIR)$@"
-	$(FSUTIL) -b $(BOOTLOADER) create $@ $(filter-out %bootloader.bin,$^)
+	$(FSUTIL) -b $(BOOTLOADER) $(if $(LOADORDER),-o $(LOADORDER)) \
+		create $@ $(filter-out %bootloader.bin $(LOADORDER),$^)
 
 # Default debugger - can be changed by passing DEBUGGER=xyz to make.
 DEBUGGER ?= gdb
@@ -91,5 +104,11 @@ run: $(EFFECT).rom $(EFFECT).exe.dbg $(EFFECT).adf
 debug: $(EFFECT).rom $(EFFECT).exe.dbg $(EFFECT).adf
 	$(LAUNCH) -d $(DEBUGGER) -r $(EFFECT).rom -e $(EFFECT).exe.dbg -f $(EFFECT).adf
 
-.PHONY: run debug run-floppy debug-floppy
+# Files are served from effect directory by tools/remotefs.py,
+# requires loader to be built with "REMOTEFS=1".
+run-remote: $(EFFECT).rom $(EFFECT).exe.dbg $(EFFECT).adf
+	$(LAUNCH) -r $(EFFECT).rom -e $(EFFECT).exe.dbg -f $(EFFECT).adf \
+		-s $(CURDIR) -s $(CURDIR)/data
+
+.PHONY: run debug run-floppy debug-floppy run-remote
 .PRECIOUS: $(BOOTLOADER)
@@ -10,8 +10,6 @@
 #define DEPTH  4
 
 static BitmapT *screen;
-static CopInsT *bplptr[DEPTH];
-static CopListT *cp;
 static short active = 0;
 
 typedef struct {
@@ -22,6 +20,7 @@ typedef struct {
 
 #include "data/running-pal.c"
 #include "data/running.c"
+#include "data/copper.c"
 
 static void Load(void) {
   screen = NewBitmap(WIDTH, HEIGHT, DEPTH + 1);
@@ -41,19 +40,19 @@ static void Init(void) {
   SetupPlayfield(MODE_LORES, DEPTH, X(0), Y(0), WIDTH, HEIGHT);
   LoadPalette(&running_pal, 0);
 
-  cp = NewCopList(100);
-  CopInit(cp);
-  CopSetupBitplanes(cp, bplptr, screen, DEPTH);
-  CopEnd(cp);
+  {
+    short i;
+
+    for (i = 0; i < DEPTH; i++)
+      CopInsSet32(copper_bplpt(i), screen->planes[i]);
+  }
 
-  CopListActivate(cp);
+  CopListActivate(copper);
   EnableDMA(DMAF_RASTER);
 }
 
 static void Kill(void) {
   DisableDMA(DMAF_COPPER | DMAF_RASTER | DMAF_BLITTER);
-
-  DeleteCopList(cp);
 }
 
 static void DrawSpans(u_char *bpl) {
@@ -100,7 +99,7 @@ static void Render(void) {
       short i = (active + n + 1 - DEPTH) % (DEPTH + 1);
       if (i < 0)
         i += DEPTH + 1;
-      CopInsSet32(bplptr[n], screen->planes[i]);
+      CopInsSet32(copper_bplpt(n), screen->planes[i]);
     }
   }
 
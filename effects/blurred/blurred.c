@@ -87,9 +87,8 @@ static void Kill(void) {
   DeleteBitmap(buffer);
 }
 
-static void RotatingTriangle(short t, short phi, short size) {
-  Point2D p[3];
-  short i, j;
+static void RotatingTriangle(Point2D *p, short t, short phi, short size) {
+  short i;
 
   /* Calculate vertices of a rotating triangle. */
   for (i = 0; i < 3; i++) {
@@ -100,19 +99,41 @@ static void RotatingTriangle(short t, short phi, short size) {
     p[i].x = normfx((short)size * (short)x) / 2 + SIZE / 2;
     p[i].y = normfx((short)size * (short)y) / 2 + SIZE / 2;
   }
+}
+
+static void TriangleLines(Line2D *line, const Point2D *p) {
+  short i;
+
+  for (i = 0; i < 3; i++, line++) {
+    const Point2D *p0 = &p[i];
+    const Point2D *p1 = &p[(i == 2) ? 0 : i + 1];
 
-  /* Create a bob with rotating triangle. */
-  for (i = 0, j = 1; i < 3; i++, j = (i == 2 ? 0 : i + 1))
-    BlitterLine(p[i].x, p[i].y, p[j].x, p[j].y);
+    line->x1 = p0->x;
+    line->y1 = p0->y;
+    line->x2 = p1->x;
+    line->y2 = p1->y;
+  }
 }
 
+/* Create a bob with three rotating triangles. */
 static void DrawShape(void) {
+  static LineCmdT cmd[9];
+  Line2D line[9];
+  Point2D p[9];
+
   BlitterClear(carry, 0);
-  BlitterLineSetup(carry, 0, LINE_EOR|LINE_ONEDOT);
 
-  RotatingTriangle(iterCount * 16, 0, SIZE - 1);
-  RotatingTriangle(iterCount * 16, SIN_PI * 2 / 3, SIZE - 1);
-  RotatingTriangle(-iterCount * 16, SIN_PI * 2 / 3, SIZE / 2 - 1);
+  RotatingTriangle(&p[0], iterCount * 16, 0, SIZE - 1);
+  RotatingTriangle(&p[3], iterCount * 16, SIN_PI * 2 / 3, SIZE - 1);
+  RotatingTriangle(&p[6], -iterCount * 16, SIN_PI * 2 / 3, SIZE / 2 - 1);
+
+  TriangleLines(&line[0], &p[0]);
+  TriangleLines(&line[3], &p[3]);
+  TriangleLines(&line[6], &p[6]);
+
+  BlitterLineSetup(carry, 0, LINE_EOR|LINE_ONEDOT);
+  BlitterLinePrepare(cmd, line, 9);
+  BlitterLineBatch(cmd, 9);
 
   BlitterFill(carry, 0);
 }
@@ -17,7 +17,6 @@ static Object3D *cube;
 static CopListT *cp;
 static CopInsT *bplptr[DEPTH];
 static BitmapT *screen0, *screen1;
-static BitmapT *scratchpad;
 static BitmapT *carry;
 
 #include "data/blurred3d-pal.c"
@@ -71,7 +70,6 @@ static void Init(void) {
   screen0 = NewBitmap(WIDTH, HEIGHT + 1, DEPTH);
   screen1 = NewBitmap(WIDTH, HEIGHT + 1, DEPTH);
   carry = NewBitmap(WIDTH, HEIGHT, 2);
-  scratchpad = NewBitmap(WIDTH, HEIGHT, 2);
 
   EnableDMA(DMAF_BLITTER | DMAF_BLITHOG);
 
@@ -88,7 +86,6 @@ static void Kill(void) {
 
   DeleteBitmap(screen0);
   DeleteBitmap(screen1);
-  DeleteBitmap(scratchpad);
   DeleteBitmap(carry);
   DeleteCopList(cp);
   DeleteObject3D(cube);
@@ -143,190 +140,24 @@ static void TransformVertices(Object3D *object) {
   } while (--n != -1);
 }
 
-static void DrawLine(short x0, short y0, short x1, short y1) {
-  short dmax = x1 - x0;
-  short dmin = y1 - y0;
-  short derr;
-  u_short bltcon1 = LINEMODE | ONEDOT;
-
-  if (dmax < 0)
-    dmax = -dmax;
-
-  if (dmax >= dmin) {
-    if (x0 >= x1)
-      bltcon1 |= AUL;
-    bltcon1 |= SUD;
-  } else {
-    if (x0 >= x1)
-      bltcon1 |= SUL;
-    swapr(dmax, dmin);
-  }
-
-  derr = 2 * dmin - dmax;
-  if (derr < 0)
-    bltcon1 |= SIGNFLAG;
-  bltcon1 |= rorw(x0 & 15, 4);
-
-  {
-    void *src = scratchpad->planes[0];
-    short start = ((y0 * WIDTH / 8) + (x0 >> 3)) & ~1;
-    void *dst = src + start;
-    u_short bltcon0 = rorw(x0 & 15, 4) | BC0F_LINE_EOR;
-    u_short bltamod = derr - dmax;
-    u_short bltbmod = 2 * dmin;
-    u_short bltsize = (dmax << 6) + 66;
-    void *bltapt = (void *)(int)derr;
-
-    WaitBlitter();
-
-    custom->bltadat = 0x8000;
-    custom->bltbdat = -1;
-    custom->bltcon0 = bltcon0;
-    custom->bltcon1 = bltcon1;
-    custom->bltamod = bltamod;
-    custom->bltbmod = bltbmod;
-    custom->bltcmod = WIDTH / 8;
-    custom->bltdmod = WIDTH / 8;
-    custom->bltapt = bltapt;
-    custom->bltcpt = dst;
-    custom->bltdpt = src;
-    custom->bltsize = bltsize;
-  }
-}
-
+/*
+ * Each face with non-zero flag, culled ones included, is xor'ed into carry.
+ * All of them get the same color, so an edge is drawn only if odd number of
+ * such faces share it. Exclusive area fill of these edges gives the same
+ * picture as filling faces one by one and xor'ing them together.
+ */
 static void DrawObject(Object3D *object) {
-  void *outbuf = carry->planes[0];
-  void *tmpbuf = scratchpad->planes[0];
-  Point3D *point = object->vertex;
   char *faceFlags = object->faceFlags;
-  IndexListT **faceEdges = object->mesh->faceEdge;
-  IndexListT **faces = object->mesh->face;
-  IndexListT *face;
-
-  custom->bltafwm = -1;
-  custom->bltalwm = -1;
-
-  while ((face = *faces++)) {
-    IndexListT *faceEdge = *faceEdges++;
-
-    if (*faceFlags++) {
-      u_short bltmod, bltsize;
-      short bltstart, bltend;
-
-      /* Estimate the size of rectangle that contains a face. */
-      {
-        short *i = face->indices;
-        Point3D *p = &point[*i++];
-        short minX = p->x;
-        short minY = p->y;
-        short maxX = minX; 
-        short maxY = minY;
-        short n = face->count - 2;
-
-        do {
-          p = &point[*i++];
-
-          if (p->x < minX)
-            minX = p->x;
-          else if (p->x > maxX)
-            maxX = p->x;
-
-          if (p->y < minY)
-            minY = p->y;
-          else if (p->y > maxY)
-            maxY = p->y;
-        } while (--n != -1);
-
-        /* Align to word boundary. */
-        minX &= ~15;
-        maxX += 16; /* to avoid case where a line is on right edge */
-        maxX &= ~15;
-
-        {
-          short w = maxX - minX;
-          short h = maxY - minY + 1;
-
-          bltstart = (minX >> 3) + minY * WIDTH / 8;
-          bltend = (maxX >> 3) + maxY * WIDTH / 8 - 2;
-          bltsize = (h << 6) | (w >> 4);
-          bltmod = (WIDTH / 8) - (w >> 3);
-        }
-      }
-
-      /* Draw face. */
-      {
-        EdgeT *edges = object->mesh->edge;
-        short m = faceEdge->count;
-        short *i = faceEdge->indices;
-
-        while (--m >= 0) {
-          short *edge = (short *)&edges[*i++];
+  short n = object->mesh->faces;
 
-          short *p0 = (void *)point + *edge++;
-          short *p1 = (void *)point + *edge++;
-
-          short x0 = *p0++;
-          short y0 = *p0++;
-          short x1 = *p1++;
-          short y1 = *p1++;
-
-          if (y0 > y1) {
-            swapr(x0, x1);
-            swapr(y0, y1);
-          }
-
-          DrawLine(x0, y0, x1, y1);
-        }
-      }
-
-      /* Fill face. */
-      {
-        void *src = tmpbuf + bltend;
-
-        WaitBlitter();
-
-        custom->bltcon0 = (SRCA | DEST) | A_TO_D;
-        custom->bltcon1 = BLITREVERSE | FILL_XOR;
-        custom->bltapt = src;
-        custom->bltdpt = src;
-        custom->bltamod = bltmod;
-        custom->bltdmod = bltmod;
-        custom->bltsize = bltsize;
-      }
-
-      /* Copy filled face to outbuf. */
-      {
-        void *src = tmpbuf + bltstart;
-        void *dst = outbuf + bltstart;
-
-        WaitBlitter();
-
-        custom->bltcon0 = (SRCA | SRCB | DEST) | A_XOR_B;
-        custom->bltcon1 = 0;
-        custom->bltapt = src;
-        custom->bltbpt = dst;
-        custom->bltdpt = dst;
-        custom->bltamod = bltmod;
-        custom->bltbmod = bltmod;
-        custom->bltdmod = bltmod;
-        custom->bltsize = bltsize;
-      }
-
-      /* Clear working area. */
-      {
-        void *data = tmpbuf + bltstart;
-
-        WaitBlitter();
-
-        custom->bltcon0 = (DEST | A_TO_D);
-        custom->bltcon1 = 0;
-        custom->bltadat = 0;
-        custom->bltdpt = data;
-        custom->bltdmod = bltmod;
-        custom->bltsize = bltsize;
-      }
-    }
+  while (--n >= 0) {
+    *faceFlags = *faceFlags ? 1 : -1;
+    faceFlags++;
   }
+
+  UpdateEdgeVisibility(object);
+  DrawEdges3D(object, carry);
+  BlitterFillArea(carry, 0, NULL, FILL_XOR);
 }
 
 static void BitmapDecSaturatedFast(BitmapT *dstbm, BitmapT *srcbm) {
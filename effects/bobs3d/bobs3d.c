@@ -2,6 +2,7 @@
 #include "blitter.h"
 #include "copper.h"
 #include "3d.h"
+#include "bob.h"
 #include "fx.h"
 
 #define WIDTH  256
@@ -14,10 +15,19 @@ static Object3D *cube;
 static CopListT *cp;
 static BitmapT *screen0, *screen1;
 static CopInsT *bplptr[DEPTH];
+static short active = 0;
 
 #include "data/flares32.c"
 #include "data/pilka.c"
 
+#define BOBW 32
+#define BOBH 32
+#define FRAMES (512 / BOBW)
+
+static BitmapT *background;
+static BitmapT *flare[FRAMES];
+static BobsT *flares;
+
 static Mesh3D *mesh = &pilka;
 
 static void MakeCopperList(CopListT *cp) {
@@ -27,14 +37,39 @@ static void MakeCopperList(CopListT *cp) {
   CopEnd(cp);
 }
 
+/* Each frame of flares sheet becomes a separate bob image. */
+static void MakeFlares(void) {
+  short i;
+
+  for (i = 0; i < FRAMES; i++) {
+    Area2D area = { i * BOBW, 0, BOBW, BOBH };
+
+    flare[i] = NewBitmapCustom(BOBW, BOBH, DEPTH,
+                               BM_DISPLAYABLE | BM_INTERLEAVED);
+    BitmapCopyArea(flare[i], 0, 0, &bobs, &area);
+  }
+}
+
+static void DeleteFlares(void) {
+  short i;
+
+  for (i = 0; i < FRAMES; i++)
+    DeleteBitmap(flare[i]);
+}
+
 static void Init(void) {
   cube = NewObject3D(mesh);
   cube->translate.z = fx4i(TZ);
 
   screen0 = NewBitmapCustom(WIDTH, HEIGHT, DEPTH,
-                            BM_DISPLAYABLE | BM_INTERLEAVED);
+                            BM_CLEAR | BM_DISPLAYABLE | BM_INTERLEAVED);
   screen1 = NewBitmapCustom(WIDTH, HEIGHT, DEPTH,
-                            BM_DISPLAYABLE | BM_INTERLEAVED);
+                            BM_CLEAR | BM_DISPLAYABLE | BM_INTERLEAVED);
+  background = NewBitmapCustom(WIDTH, HEIGHT, DEPTH,
+                               BM_CLEAR | BM_DISPLAYABLE | BM_INTERLEAVED);
+
+  MakeFlares();
+  flares = NewBobs(background, mesh->vertices);
 
   SetupPlayfield(MODE_LORES, DEPTH, X(32), Y(0), WIDTH, HEIGHT);
   LoadPalette(&bobs_pal, 0);
@@ -48,6 +83,9 @@ static void Init(void) {
 static void Kill(void) {
   DeleteCopList(cp);
   DisableDMA(DMAF_RASTER | DMAF_BLITTER | DMAF_BLITHOG);
+  DeleteBobs(flares);
+  DeleteFlares();
+  DeleteBitmap(background);
   DeleteBitmap(screen0);
   DeleteBitmap(screen1);
   DeleteObject3D(cube);
@@ -113,123 +151,43 @@ static void TransformVertices(Object3D *object) {
   } while (--n > 0);
 }
 
-#define BOBW 32
-#define BOBH 32
-
-#define OPTIMIZED 1
-
-#if OPTIMIZED
-#define SRCROW (512 / 8)
-#define DSTROW (256 / 8)
-#else
-#define SRCROW src->bytesPerRow
-#define DSTROW dst->bytesPerRow
-#endif
-
-void BlitterOrArea(BitmapT *dst asm("a0"), u_short x asm("d0"), u_short y asm("d1"),
-                   const BitmapT *src asm("a1"), u_short sx asm("d2"))
-{
-  u_short dxo = x & 15;
-  u_short width = dxo + BOBW;
-  u_short wo = width & 15;
-  u_short bytesPerRow = ((width + 15) & ~15) >> 3;
-  u_short srcmod = SRCROW - bytesPerRow;
-  u_short dstmod = DSTROW - bytesPerRow;
-  u_short bltafwm = FirstWordMask[dxo];
-  u_short bltalwm = LastWordMask[wo];
-  u_short bltshift = rorw(dxo, 4);
-
-  u_int src_start = (sx & ~15) >> 3;
-  u_int dst_start = ((x & ~15) >> 3) + y * DSTROW * DEPTH;
-  u_short bltsize = (BOBH * DEPTH << 6) | (bytesPerRow >> 1);
-
-  void *srcbpt = src->planes[0] + src_start;
-  void *dstbpt = dst->planes[0] + dst_start;
-
-  bool fast = (dxo == 0);
-
-  WaitBlitter();
-
-  if (fast) {
-    custom->bltcon0 = (SRCA | SRCB | DEST) | A_OR_B;
-    custom->bltcon1 = 0;
-    custom->bltafwm = -1;
-    custom->bltalwm = -1;
-    custom->bltamod = srcmod;
-    custom->bltbmod = dstmod;
-    custom->bltdmod = dstmod;
-
-    custom->bltapt = srcbpt;
-    custom->bltbpt = dstbpt;
-    custom->bltdpt = dstbpt;
-    custom->bltsize = bltsize;
-  } else {
-    /* AB + C */
-    custom->bltcon0 = (SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NABC | NANBC);
-    custom->bltcon1 = bltshift;
-    custom->bltadat = -1;
-    custom->bltafwm = bltafwm;
-    custom->bltalwm = bltalwm;
-    custom->bltbmod = srcmod;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
-
-    custom->bltbpt = srcbpt;
-    custom->bltcpt = dstbpt;
-    custom->bltdpt = dstbpt;
-    custom->bltsize = bltsize;
-  }
-}
-
-static void DrawObject(Object3D *object, BitmapT *dst) {
-  short *data = (short *)object->vertex;
-  register short n asm("d7") = object->mesh->vertices;
-
-#if 0
-  short minZ = 32767, maxZ = -32768;
-#endif
+/* Flares have no masks, so they are or'ed together in any order. */
+static void DrawObject(Object3D *object, const BitmapT *dst) {
+  Point3D *p = object->vertex;
+  BobT *bob = flares->bob;
+  short n = object->mesh->vertices;
 
-  do {
-    short x = *data++;
-    short y = *data++;
-    short z = *data++;
+  while (--n >= 0) {
+    short z = p->z;
 
     z >>= 4;
     z -= TZ;
     z += 128 - 32;
     z = z + z + z - 32;
-    z &= ~31;
-
-#if 0
-    if (z < minZ)
-      minZ = z;
-    if (z > maxZ)
-      maxZ = z;
-#endif
+    z >>= 5;
 
-    BlitterOrArea(dst, x - 16, y - 16, &bobs, z);
+    if (z < 0)
+      z = 0;
+    if (z > FRAMES - 1)
+      z = FRAMES - 1;
 
-    data++;
-  } while (--n > 0);
-}
+    bob->bitmap = flare[z];
+    bob->mask = NULL;
+    bob->x = p->x - BOBW / 2;
+    bob->y = p->y - BOBH / 2;
+    bob->visible = true;
 
-static void BitmapClearI(BitmapT *bm) {
-  WaitBlitter();
+    p++;
+    bob++;
+  }
 
-  custom->bltadat = 0;
-  custom->bltcon0 = DEST | A_TO_D;
-  custom->bltcon1 = 0;
-  custom->bltdmod = 0;
-  custom->bltdpt = bm->planes[0];
-  custom->bltsize = ((bm->height * bm->depth) << 6) | (bm->bytesPerRow >> 1);
+  BobsDraw(flares, dst, active);
 }
 
 PROFILE(TransformObject);
 PROFILE(DrawObject);
 
 static void Render(void) {
-  BitmapClearI(screen0);
-
   ProfilerStart(TransformObject);
   {
     cube->rotate.x = cube->rotate.y = cube->rotate.z = frameCount * 12;
@@ -239,10 +197,9 @@ static void Render(void) {
   }
   ProfilerStop(TransformObject);
 
-  WaitBlitter();
-
   ProfilerStart(DrawObject);
   {
+    BobsRestore(flares, screen0, active);
     DrawObject(cube, screen0);
   }
   ProfilerStop(DrawObject);
@@ -251,6 +208,7 @@ static void Render(void) {
 
   CopUpdateBitplanes(bplptr, screen0, DEPTH);
   swapr(screen0, screen1);
+  active ^= 1;
 }
 
 EFFECT(bobs3d, NULL, NULL, Init, Kill, Render);
@@ -1,4 +1,3 @@
-#include <strings.h>
 #include "effect.h"
 #include "blitter.h"
 #include "copper.h"
@@ -55,43 +54,6 @@ static void Kill(void) {
   DeleteObject3D(cube);
 }
 
-static void UpdateEdgeVisibilityConvex(Object3D *object) {
-  char *vertexFlags = object->vertexFlags;
-  char *edgeFlags = object->edgeFlags;
-  char *faceFlags = object->faceFlags;
-  IndexListT **faces = object->mesh->face;
-  IndexListT *face = *faces++;
-  IndexListT **faceEdges = object->mesh->faceEdge;
-  IndexListT *faceEdge = *faceEdges++;
-
-  bzero(vertexFlags, object->mesh->vertices);
-  bzero(edgeFlags, object->mesh->edges);
-
-  do {
-    char f = *faceFlags++;
-
-    if (f >= 0) {
-      short n = face->count - 3;
-      short *vi = face->indices;
-      short *ei = faceEdge->indices;
-
-      /* Face has at least (and usually) three vertices / edges. */
-      vertexFlags[*vi++] = -1;
-      edgeFlags[*ei++] ^= f;
-      vertexFlags[*vi++] = -1;
-      edgeFlags[*ei++] ^= f;
-
-      do {
-        vertexFlags[*vi++] = -1;
-        edgeFlags[*ei++] ^= f;
-      } while (--n != -1);
-    }
-
-    faceEdge = *faceEdges++;
-    face = *faces++;
-  } while (face);
-}
-
 #define MULVERTEX1(D, E) {               \
   short t0 = (*v++) + y;                  \
   short t1 = (*v++) + x;                  \
@@ -163,113 +125,6 @@ static void TransformVertices(Object3D *object) {
   } while (--n != -1);
 }
 
-static void DrawObject(BitmapT *screen, Object3D *object,
-                       CustomPtrT custom_ asm("a6"))
-{
-  short *edge = (short *)object->mesh->edge;
-  char *edgeFlags = object->edgeFlags;
-  Point3D *point = object->vertex;
-  short n = object->mesh->edges - 1;
-  void *planes = screen->planes[0];
-
-  WaitBlitter();
-  custom_->bltafwm = -1;
-  custom_->bltalwm = -1;
-  custom_->bltadat = 0x8000;
-  custom_->bltbdat = 0xffff; /* Line texture pattern. */
-  custom_->bltcmod = WIDTH / 8;
-  custom_->bltdmod = WIDTH / 8;
-
-  do {
-    char f = *edgeFlags++;
-
-    if (f) {
-      short x0, y0, x1, y1;
-      void *data;
-
-      {
-        short *p0 = (void *)point + *edge++;
-        x0 = *p0++;
-        y0 = *p0++;
-      }
-      
-      {
-        short *p1 = (void *)point + *edge++;
-        x1 = *p1++;
-        y1 = *p1++;
-      }
-
-      if (y0 > y1) {
-        swapr(x0, x1);
-        swapr(y0, y1);
-      }
-
-      {
-        short dmax = x1 - x0;
-        short dmin = y1 - y0;
-        short derr;
-        u_short bltcon1 = LINEMODE | ONEDOT;
-
-        if (dmax < 0)
-          dmax = -dmax;
-
-        if (dmax >= dmin) {
-          if (x0 >= x1)
-            bltcon1 |= (AUL | SUD);
-          else
-            bltcon1 |= SUD;
-        } else {
-          if (x0 >= x1)
-            bltcon1 |= SUL;
-          swapr(dmax, dmin);
-        }
-
-        {
-          short y0_ = y0 << 5;
-          short x0_ = x0 >> 3;
-          short start = (y0_ + x0_) & ~1;
-          data = planes + start;
-        }
-
-        dmin <<= 1;
-        derr = dmin - dmax;
-        if (derr < 0)
-          bltcon1 |= SIGNFLAG;
-        bltcon1 |= rorw(x0 & 15, 4);
-
-        {
-          u_short bltcon0 = rorw(x0 & 15, 4) | BC0F_LINE_EOR;
-          u_short bltamod = derr - dmax;
-          u_short bltbmod = dmin;
-          u_short bltsize = (dmax << 6) + 66;
-          void *bltapt = (void *)(int)derr;
-          
-#define DRAWLINE()                      \
-          WaitBlitter();                \
-          custom_->bltcon0 = bltcon0;    \
-          custom_->bltcon1 = bltcon1;    \
-          custom_->bltcpt = data;        \
-          custom_->bltapt = bltapt;      \
-          custom_->bltdpt = planes;      \
-          custom_->bltbmod = bltbmod;    \
-          custom_->bltamod = bltamod;    \
-          custom_->bltsize = bltsize;
-
-          if (f & 1) { DRAWLINE(); }
-          data += WIDTH * HEIGHT / 8;
-          if (f & 2) { DRAWLINE(); }
-          data += WIDTH * HEIGHT / 8;
-          if (f & 4) { DRAWLINE(); }
-          data += WIDTH * HEIGHT / 8;
-          if (f & 8) { DRAWLINE(); }
-        }
-      }
-    } else {
-      edge += 2;
-    }
-  } while (--n != -1);
-}
-
 static void BitmapClearFast(BitmapT *dst) {
   u_short height = (short)dst->height * (short)dst->depth;
   u_short bltsize = (height << 6) | (dst->bytesPerRow >> 1);
@@ -320,14 +175,14 @@ static void Render(void) {
   {
     UpdateObjectTransformation(cube); // 18 lines
     UpdateFaceVisibility(cube); // 211 lines O(faces)
-    UpdateEdgeVisibilityConvex(cube); // 78 lines O(edge)
+    UpdateEdgeVisibility(cube); // 78 lines O(edge)
     TransformVertices(cube); // 89 lines O(vertex)
   }
   ProfilerStop(Transform);
 
   ProfilerStart(Draw);
   {
-    DrawObject(screen[active], cube, custom); // 237 lines
+    DrawEdges3D(cube, screen[active]); // 237 lines
   }
   ProfilerStop(Draw);
 
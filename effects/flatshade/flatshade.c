@@ -55,74 +55,6 @@ static void Kill(void) {
   DeleteObject3D(cube);
 }
 
-#define MULVERTEX1(D, E) {               \
-  short t0 = (*v++) + y;                  \
-  short t1 = (*v++) + x;                  \
-  int t2 = (*v++) * z;                  \
-  v++;                                   \
-  D = ((t0 * t1 + t2 - x * y) >> 4) + E; \
-}
-
-#define MULVERTEX2(D) {                  \
-  short t0 = (*v++) + y;                  \
-  short t1 = (*v++) + x;                  \
-  int t2 = (*v++) * z;                  \
-  short t3 = (*v++);                      \
-  D = normfx(t0 * t1 + t2 - x * y) + t3; \
-}
-
-static void TransformVertices(Object3D *object) {
-  Matrix3D *M = &object->objectToWorld;
-  short *v = (short *)M;
-  short *src = (short *)object->mesh->vertex;
-  short *dst = (short *)object->vertex;
-  char *flags = object->vertexFlags;
-  register short n asm("d7") = object->mesh->vertices - 1;
-
-  int m0 = (M->x << 8) - ((M->m00 * M->m01) >> 4);
-  int m1 = (M->y << 8) - ((M->m10 * M->m11) >> 4);
-
-  /* WARNING! This modifies camera matrix! */
-  M->z -= normfx(M->m20 * M->m21);
-
-  /*
-   * A = m00 * m01
-   * B = m10 * m11
-   * C = m20 * m21 
-   * yx = y * x
-   *
-   * (m00 + y) * (m01 + x) + m02 * z - yx + (mx - A)
-   * (m10 + y) * (m11 + x) + m12 * z - yx + (my - B)
-   * (m20 + y) * (m21 + x) + m22 * z - yx + (mz - C)
-   */
-
-  do {
-    if (*flags++) {
-      short x = *src++;
-      short y = *src++;
-      short z = *src++;
-      int xp, yp;
-      short zp;
-
-      pushl(v);
-      MULVERTEX1(xp, m0);
-      MULVERTEX1(yp, m1);
-      MULVERTEX2(zp);
-      popl(v);
-
-      *dst++ = div16(xp, zp) + WIDTH / 2;  /* div(xp * 256, zp) */
-      *dst++ = div16(yp, zp) + HEIGHT / 2; /* div(yp * 256, zp) */
-      *dst++ = zp;
-
-      src++;
-      dst++;
-    } else {
-      src += 4;
-      dst += 4;
-    }
-  } while (--n != -1);
-}
-
 static void DrawObject(Object3D *object, CustomPtrT custom_ asm("a6")) {
   IndexListT **faces = object->mesh->face;
   SortItemT *item = object->visibleFace;
@@ -333,6 +265,7 @@ static void BitmapClearFast(BitmapT *dst) {
 
 PROFILE(Transform);
 PROFILE(Draw);
+PROFILE_COUNTER(SortFaces, "moves");
 
 static void Render(void) {
   BitmapClearFast(screen0);
@@ -341,12 +274,11 @@ static void Render(void) {
   {
     cube->rotate.x = cube->rotate.y = cube->rotate.z = frameCount * 8;
     UpdateObjectTransformation(cube);
-    UpdateFaceVisibility(cube);
-    UpdateVertexVisibility(cube);
-    TransformVertices(cube);
-    SortFaces(cube);
+    ProjectObject3D(cube, WIDTH / 2, HEIGHT / 2);
+    OrderFaces(cube);
   }
   ProfilerStop(Transform);
+  ProfilerCount(SortFaces, cube->sortWork);
 
   ProfilerStart(Draw);
   {
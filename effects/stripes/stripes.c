@@ -2,6 +2,7 @@
 #include "copper.h"
 #include "fx.h"
 #include "color.h"
+#include "memory.h"
 #include <stdlib.h>
 
 #define WIDTH   320
@@ -15,11 +16,12 @@ typedef struct {
   short color;
 } StripeT;
 
-static CopListT *cp[2];
-static CopInsT *lineColor[2][HEIGHT];
+static CopPatchT *lineColor;
 static StripeT stripe[STRIPES];
 static short active = 0;
 
+#include "data/copper.c"
+
 static u_short colorSet[4] = { 0xC0F, 0xF0C, 0x80F, 0xF08 };
 static u_short colorShades[4 * 32];
 
@@ -49,38 +51,23 @@ static void GenerateColorShades(void) {
   }
 }
 
-static void MakeCopperList(CopListT *cp, CopInsT **line) {
-  short i;
-
-  CopInit(cp);
-  CopSetColor(cp, 0, BGCOL);
-
-  for (i = 0; i < HEIGHT; i++) {
-    CopWaitSafe(cp, Y(i), 8);
-    *line++ = CopSetColor(cp, 0, 0);
-  }
-
-  CopWait(cp, Y(256), 8);
-  CopSetColor(cp, 0, BGCOL);
-  CopEnd(cp);
-}
-
 static void Init(void) {
+  short i, n;
+
   GenerateStripes();
   GenerateColorShades();
 
-  cp[0] = NewCopList(HEIGHT * 2 + 100);
-  cp[1] = NewCopList(HEIGHT * 2 + 100);
+  lineColor = NewCopPatch(HEIGHT, MEMF_PUBLIC);
 
-  MakeCopperList(cp[0], lineColor[0]);
-  MakeCopperList(cp[1], lineColor[1]);
+  for (n = 0; n < 2; n++)
+    for (i = 0; i < HEIGHT; i++)
+      CopPatchBind(lineColor, n, i, copper_line(n, i));
 
-  CopListActivate(cp[0]);
+  CopListActivate(copper(0));
 }
 
 static void Kill(void) {
-  DeleteCopList(cp[0]);
-  DeleteCopList(cp[1]);
+  DeleteCopPatch(lineColor);
 }
 
 static short centerY = 0;
@@ -106,15 +93,15 @@ static void RotateStripes(short *d, short *s, short rotate) {
 }
 
 static void ClearLineColor(void) {
-  CopInsT **line = lineColor[active];
+  short *line = lineColor->value;
   short n = HEIGHT;
 
   while (--n >= 0)
-    CopInsSet16(*line++, BGCOL);
+    *line++ = BGCOL;
 }
 
 static void SetLineColor(short *s) {
-  CopInsT **lines = lineColor[active];
+  short *lines = lineColor->value;
   short n = STRIPES;
   u_short *shades = colorShades;
 
@@ -133,18 +120,18 @@ static void SetLineColor(short *s) {
       l = 31;
 
     {
-      CopInsT **line = &lines[i];
+      short *line = &lines[i];
       short c0 = shades[color | l];
       short c1 = shades[color | (l >> 1)];
 
       h -= 2;
 
-      CopInsSet16(*line++, c1);
+      *line++ = c1;
 
       while (--h >= 0)
-        CopInsSet16(*line++, c0);
+        *line++ = c0;
 
-      CopInsSet16(*line++, c1);
+      *line++ = c1;
     }
   }
 }
@@ -170,6 +157,7 @@ static void RenderStripes(short rotate) {
   SortStripes(temp);
   ClearLineColor();
   SetLineColor((short *)temp);
+  CopPatchUpdate(lineColor, active);
 }
 
 PROFILE(RenderStripes);
@@ -181,7 +169,7 @@ static void Render(void) {
   }
   ProfilerStop(RenderStripes);
 
-  CopListRun(cp[active]);
+  CopListRun(copper(active));
   TaskWaitVBlank();
   active ^= 1;
 }
@@ -1,24 +1,27 @@
 #include "effect.h"
 #include "blitter.h"
 #include "copper.h"
-#include "interrupt.h"
+#include "c2p.h"
 #include "memory.h"
 #include "pixmap.h"
 
 #define WIDTH 160
 #define HEIGHT 100
 #define DEPTH 4
-#define FULLPIXEL 1
+
+/* Also used by data/copper.cop, so it is set in Makefile. */
+#ifndef FULLPIXEL
+#error "FULLPIXEL not defined!"
+#endif
 
 static u_short *textureHi, *textureLo;
 static BitmapT *screen[2];
 static u_short active = 0;
-static CopListT *cp;
-static CopInsT *bplptr[DEPTH];
 
 #include "data/texture-16-1.c"
 #include "data/gradient.c"
 #include "data/uvmap.c"
+#include "data/copper.c"
 
 #define UVMapRenderSize (WIDTH * HEIGHT / 2 * 10 + 2)
 void (*UVMapRender)(u_short *chunkyEnd asm("a0"),
@@ -91,162 +94,89 @@ static void MakeUVMapRenderCode(void) {
   *code++ = 0x4e75; /* rts */
 }
 
-static struct {
-  short phase;
-  void **bpl;
-} c2p = { 256, NULL };
+static C2PT *c2p;
 
 #define BLTSIZE ((WIDTH / 2) * HEIGHT) /* 8000 bytes */
 
 /* If you think you can speed it up (I doubt it) please first look into
  * `c2p_2x1_4bpl_mangled_fast_blitter.py` in `prototypes/c2p`. */
 
-static void ChunkyToPlanar(void) {
-  register void **bpl asm("a0") = c2p.bpl;
-
-  /*
-   * Our chunky buffer of size (WIDTH/2, HEIGHT/2) is stored in bpl[0].
-   * Each 32-bit long word of chunky buffer contains eight 4-bit pixels
-   * [a b c d e f g h] in scrambled format described below.
-   * Please note that a_i is the i-th least significant bit of a.
-   *
-   * [a0 a1 b0 b1 a2 a3 b2 b3 e0 e1 f0 f1 e2 e3 f2 f3
-   *  c0 c1 d0 d1 c2 c3 d2 d3 g0 g1 h0 h1 g2 g3 h2 h3]
-   *
-   * So not only pixels in the texture must be scrambled, but also consecutive
-   * bytes of input buffer i.e.: [a b] [e f] [c d] [g h] (see `gen-uvmap.py`).
-   *
-   * Chunky to planar is divided into two major steps:
-   * 
-   * Swap 4x2: in two consecutive 16-bit words swap diagonally two bits,
-   *           i.e. [b0 b1] <-> [c0 c1], [b2 b3] <-> [c2 c3].
-   * Expand 2x1: [x0 x1 ...] is translated into [x0 x0 ...] and [x1 x1 ...]
-   *             and copied to corresponding bitplanes, this step effectively
-   *             stretches pixels to 2x1.
-   *
-   * Line doubling is performed using copper. Rendered bitmap will have size
-   * (WIDTH, HEIGHT/2, DEPTH) and will be placed in bpl[2] and bpl[3].
-   */
-
-  ClearIRQ(INTF_BLIT);
-
-  switch (c2p.phase) {
-    case 0:
-      /* Initialize chunky to planar. */
-      custom->bltamod = 2;
-      custom->bltbmod = 2;
-      custom->bltdmod = 0;
-      custom->bltcdat = 0xF0F0;
-      custom->bltafwm = -1;
-      custom->bltalwm = -1;
-
-      /* Swap 4x2, pass 1, high-bits. */
-      custom->bltapt = bpl[0];
-      custom->bltbpt = bpl[0] + 2;
-      custom->bltdpt = bpl[1] + BLTSIZE / 2;
-
-      /* (a & 0xF0F0) | ((b >> 4) & ~0xF0F0) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC);
-      custom->bltcon1 = BSHIFT(4);
-
-    case 1:
-      /* overall size: BLTSIZE / 2 bytes */
-      custom->bltsize = 1 | ((BLTSIZE / 8) << 6);
-      break;
-
-    case 2:
-      /* Swap 4x2, pass 2, low-bits. */
-      custom->bltapt = bpl[1] - 4;
-      custom->bltbpt = bpl[1] - 2;
-      custom->bltdpt = bpl[1] + BLTSIZE / 2 - 2;
-
-      /* ((a << 4) & 0xF0F0) | (b & ~0xF0F0) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC) | ASHIFT(4);
-      custom->bltcon1 = BLITREVERSE;
-
-    case 3:
-      /* overall size: BLTSIZE / 2 bytes */
-      custom->bltsize = 1 | ((BLTSIZE / 8) << 6);
-      break;
-
-    case 4:
-      custom->bltamod = 0;
-      custom->bltbmod = 0;
-      custom->bltdmod = 0;
-      custom->bltcdat = 0xAAAA;
-
-      custom->bltapt = bpl[1];
-      custom->bltbpt = bpl[1];
-      custom->bltdpt = bpl[3];
+/*
+ * Our chunky buffer of size (WIDTH/2, HEIGHT/2) is stored in bpl[0].
+ * Each 32-bit long word of chunky buffer contains eight 4-bit pixels
+ * [a b c d e f g h] in scrambled format described below.
+ * Please note that a_i is the i-th least significant bit of a.
+ *
+ * [a0 a1 b0 b1 a2 a3 b2 b3 e0 e1 f0 f1 e2 e3 f2 f3
+ *  c0 c1 d0 d1 c2 c3 d2 d3 g0 g1 h0 h1 g2 g3 h2 h3]
+ *
+ * So not only pixels in the texture must be scrambled, but also consecutive
+ * bytes of input buffer i.e.: [a b] [e f] [c d] [g h] (see `gen-uvmap.py`).
+ *
+ * Chunky to planar is divided into two major steps:
+ * 
+ * Swap 4x2: in two consecutive 16-bit words swap diagonally two bits,
+ *           i.e. [b0 b1] <-> [c0 c1], [b2 b3] <-> [c2 c3].
+ * Expand 2x1: [x0 x1 ...] is translated into [x0 x0 ...] and [x1 x1 ...]
+ *             and copied to corresponding bitplanes, this step effectively
+ *             stretches pixels to 2x1.
+ *
+ * Line doubling is performed using copper. Rendered bitmap will have size
+ * (WIDTH, HEIGHT/2, DEPTH) and will be placed in bpl[2] and bpl[3].
+ * bpl[1] serves as intermediate buffer.
+ */
 
 #if FULLPIXEL
-      /* (a & 0xAAAA) | ((b >> 1) & ~0xAAAA) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC);
-      custom->bltcon1 = BSHIFT(1);
+#define UVMapLayout C2PLayout2x1x4MangledFast
 #else
-      /* (a & 0xAAAA) */
-      custom->bltcon0 = (SRCA | DEST) | (ABC | ANBC);
-      custom->bltcon1 = 0;
+/* Each bitplane gets every other column of pixels, which are shifted by one
+ * pixel on odd lines by copper. */
+static const C2PPassT HalfPixelPasses[] = {
+  /* Swap 4x2, pass 1: (a & 0xF0F0) | ((b >> 4) & ~0xF0F0) */
+  { { C2P_CHUNKY, 0, 0, 1 }, { C2P_CHUNKY, 0, 1, 1 }, { C2P_TEMP, 2, 0, 0 },
+    0xF0F0, 0, 4, false, 1, 2 },
+  /* Swap 4x2, pass 2: ((a << 4) & 0xF0F0) | (b & ~0xF0F0) */
+  { { C2P_CHUNKY, 0, 0, 1 }, { C2P_CHUNKY, 0, 1, 1 }, { C2P_TEMP, 0, 0, 0 },
+    0xF0F0, 4, 0, true, 1, 2 },
+  /* (a & 0xAAAA) */
+  { { C2P_TEMP, 0, 0, 0 }, { C2P_NONE, 0, 0, 0 }, { C2P_OUTPUT(1), 0, 0, 0 },
+    0xAAAA, 0, 0, false, 4, 4 },
+  /* (a & ~0xAAAA) */
+  { { C2P_TEMP, 0, 0, 0 }, { C2P_NONE, 0, 0, 0 }, { C2P_OUTPUT(0), 0, 0, 0 },
+    0x5555, 0, 0, false, 4, 4 },
+};
+
+static const C2PLayoutT UVMapLayout = {
+  "2x1x4-mangled-halfpixel", NULL,
+  sizeof(HalfPixelPasses) / sizeof(C2PPassT), 2, 4, false, HalfPixelPasses
+};
 #endif
-      /* overall size: BLTSIZE bytes */
-      custom->bltsize = 4 | ((BLTSIZE / 8) << 6);
-      break;
 
-    case 5:
-      custom->bltapt = bpl[1] + BLTSIZE - 2;
-      custom->bltbpt = bpl[1] + BLTSIZE - 2;
-      custom->bltdpt = bpl[2] + BLTSIZE - 2;
-      custom->bltcdat = 0xAAAA;
+/* Called by blitter interrupt handler when the last pass has finished. */
+static void ChunkyToPlanarDone(void *data) {
+  void **bpl = data;
 
-#if FULLPIXEL
-      /* ((a << 1) & 0xAAAA) | (b & ~0xAAAA) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC) | ASHIFT(1);
-      custom->bltcon1 = BLITREVERSE;
-#else
-      /* (a & ~0xAAAA) */
-      custom->bltcon0 = (SRCA | DEST) | (ABNC | ANBNC);
-      custom->bltcon1 = BLITREVERSE;
-#endif
-      /* overall size: BLTSIZE bytes */
-      custom->bltsize = 4 | ((BLTSIZE / 8) << 6);
-      break;
-
-    case 6:
-      CopInsSet32(bplptr[0], bpl[2]);
-      CopInsSet32(bplptr[1], bpl[3]);
-      CopInsSet32(bplptr[2], bpl[2] + BLTSIZE / 2);
-      CopInsSet32(bplptr[3], bpl[3] + BLTSIZE / 2);
-      break;
-
-    default:
-      break;
-  }
+  CopInsSet32(copper_bplpt(0), bpl[2]);
+  CopInsSet32(copper_bplpt(1), bpl[3]);
+  CopInsSet32(copper_bplpt(2), bpl[2] + BLTSIZE / 2);
+  CopInsSet32(copper_bplpt(3), bpl[3] + BLTSIZE / 2);
+}
 
-  c2p.phase++;
+static void ChunkyToPlanar(void **bpl) {
+  void *output[2] = { bpl[2], bpl[3] };
+
+  C2PSetBuffers(c2p, bpl[0], bpl[1], output);
+  C2PStart(c2p, ChunkyToPlanarDone, bpl);
 }
 
-static void MakeCopperList(CopListT *cp) {
+static void SetupCopperList(void) {
   short *pixels = gradient.pixels;
-  short i, j;
-
-  CopInit(cp);
-  CopSetupBitplanes(cp, bplptr, screen[active], DEPTH);
-  for (j = 0; j < 16; j++)
-    CopSetColor(cp, j, *pixels++);
-  for (i = 0; i < HEIGHT * 2; i++) {
-    CopWaitSafe(cp, Y(i + 28), 0);
-    /* Line doubling. */
-    CopMove16(cp, bpl1mod, (i & 1) ? 0 : -40);
-    CopMove16(cp, bpl2mod, (i & 1) ? 0 : -40);
-#if !FULLPIXEL
-    /* Alternating shift by one for bitplane data. */
-    CopMove16(cp, bplcon1, (i & 1) ? 0x0010 : 0x0021);
-#endif
-    if (i % 13 == 12)
-      for (j = 0; j < 16; j++)
-        CopSetColor(cp, j, *pixels++);
-  }
-  CopEnd(cp);
+  short i;
+
+  for (i = 0; i < DEPTH; i++)
+    CopInsSet32(copper_bplpt(i), screen[active]->planes[i]);
+  for (i = 0; i < copper_color_count; i++)
+    CopInsSet16(copper_color(i), *pixels++);
 }
 
 static void Init(void) {
@@ -267,23 +197,22 @@ static void Init(void) {
 
   SetupPlayfield(MODE_LORES, DEPTH, X(0), Y(28), WIDTH * 2, HEIGHT * 2);
 
-  cp = NewCopList(900 + 256);
-  MakeCopperList(cp);
-  CopListActivate(cp);
+  SetupCopperList();
+  CopListActivate(copper);
 
   EnableDMA(DMAF_RASTER);
 
-  SetIntVector(BLIT, (IntHandlerT)ChunkyToPlanar, NULL);
-  EnableINT(INTF_BLIT);
+  InitBlitQueue();
+  c2p = NewC2P(&UVMapLayout, BLTSIZE / 2);
 }
 
 static void Kill(void) {
-  DisableDMA(DMAF_COPPER | DMAF_RASTER | DMAF_BLITTER);
+  /* Pending c2p blits must finish while blitter DMA is still on. */
+  KillBlitQueue();
+  DeleteC2P(c2p);
 
-  DisableINT(INTF_BLIT);
-  ResetIntVector(BLIT);
+  DisableDMA(DMAF_COPPER | DMAF_RASTER | DMAF_BLITTER);
 
-  DeleteCopList(cp);
   MemFree(textureHi);
   MemFree(textureLo);
   MemFree(UVMapRender);
@@ -309,9 +238,7 @@ static void Render(void) {
   }
   ProfilerStop(UVMap);
 
-  c2p.phase = 0;
-  c2p.bpl = screen[active]->planes;
-  ChunkyToPlanar();
+  ChunkyToPlanar(screen[active]->planes);
   active ^= 1;
 }
 
@@ -44,7 +44,14 @@ typedef struct {
 
 extern Frustum3D ClipFrustum;
 
-void PointsInsideFrustum(Point3D *in, u_char *flags, u_short n);
+/*
+ * Frustum planes are x = z, x = -z, y = z and y = -z, i.e. field of view is
+ * 90 degrees in camera space. Points inside have negative z.
+ */
+
+/* Returns outcodes of all points or'ed together. */
+u_char PointsInsideFrustum(Point3D *in, u_char *flags, u_short n);
+void ClipEdge3D(Point3D *o, Point3D *s, Point3D *e, u_short plane);
 u_short ClipPolygon3D(Point3D *in, Point3D **outp, u_short n,
                       u_short clipFlags);
 
@@ -61,12 +68,26 @@ typedef struct {
   short  texture;
 } MeshSurfaceT;
 
+/* Vertices or face normals moved by a morph target at full weight. */
+typedef struct {
+  short offset;            /* byte offset into Point3D array */
+  short x, y, z;
+} MorphDeltaT;
+
+typedef struct {
+  short vertices;
+  short faces;
+  MorphDeltaT *vertex;
+  MorphDeltaT *faceNormal;
+} MorphTargetT;
+
 typedef struct {
   short vertices;
   short faces;
   short edges;
   short surfaces;
   short images;
+  short morphs;
 
   Point3D *vertex;
   UVCoord *uv;
@@ -81,14 +102,46 @@ typedef struct {
 
   MeshImageT **image;
   MeshSurfaceT *surface;
+  MorphTargetT *morph;     /* lwo2c exports MORF and SPOT vertex maps */
+
+  u_short allocated;       /* structures calculated at run time */
 } Mesh3D;
 
+/* Calculate* functions do nothing if lwo2c already provided the data. */
+#define MESH_FACE_NORMAL   1
+#define MESH_VERTEX_NORMAL 2
+#define MESH_EDGES         4
+#define MESH_VERTEX_FACE   8
+
 void CalculateEdges(Mesh3D *mesh);
 void CalculateVertexFaceMap(Mesh3D *mesh);
 void CalculateVertexNormals(Mesh3D *mesh);
 void CalculateFaceNormals(Mesh3D *mesh);
 void ResetMesh3D(Mesh3D *mesh);
 
+/* Simplified versions of a mesh generated by lwo2c, most detailed first. */
+typedef struct {
+  short error;  /* how far simplification moved vertices */
+  Mesh3D *mesh;
+} MeshLevelT;
+
+typedef struct {
+  short levels;
+  MeshLevelT level[];
+} MeshLOD3D;
+
+short SelectMeshLOD(MeshLOD3D *lod, short z, short maxError);
+
+/*
+ * Morphed mesh shares everything with its base mesh but vertices and face
+ * normals, which are rebuilt by BlendMorphs3D. Weights are fx12 values, one
+ * for each morph target of base mesh, usually read from sync tracks. Vertex
+ * normals are not blended.
+ */
+Mesh3D *NewMorphedMesh3D(Mesh3D *base);
+void DeleteMorphedMesh3D(Mesh3D *mesh);
+void BlendMorphs3D(Mesh3D *mesh, Mesh3D *base, short *weight);
+
 /* 3D object representation */
 
 typedef struct {
@@ -107,11 +160,18 @@ typedef struct {
   char *vertexFlags;   /* used by clipping */
   char *faceFlags;     /* e.g. visiblity flags */
   char *edgeFlags;
+  Point3D *edgeClip;   /* intersection of an edge with plane given by pad */
 
   SortItemT *visibleFace;
+  SortItemT *sortBuffer; /* temporary space for SortFaces */
   short visibleFaces;
+  short *faceDepth;      /* face depth keys calculated by SortFaces */
+  u_short sortWork;      /* number of items moved by last SortFaces */
 } Object3D;
 
+/* faceDepth of invisible faces */
+#define NOFACE ((short)0x8000)
+
 Object3D *NewObject3D(Mesh3D *mesh);
 void DeleteObject3D(Object3D *object);
 void UpdateFaceNormals(Object3D *object);
@@ -119,5 +179,101 @@ void UpdateObjectTransformation(Object3D *object);
 void UpdateFaceVisibility(Object3D *object);
 void UpdateVertexVisibility(Object3D *object);
 void SortFaces(Object3D *object);
+void OrderFaces(Object3D *object);
+
+/*
+ * Renders convex objects with each edge drawn once. UpdateEdgeVisibility
+ * marks edges of visible faces with xor of their colors. DrawEdges3D draws
+ * marked edges in screen space into bitplanes that are to be area filled.
+ */
+void UpdateEdgeVisibility(Object3D *object);
+void DrawEdges3D(Object3D *object, const BitmapT *bitmap);
+
+/*
+ * Replaces UpdateFaceVisibility, UpdateVertexVisibility, transformation of
+ * vertices and depth calculation of SortFaces with a single pass over faces.
+ * Vertices are projected onto screen with (cx, cy) as the center. Follow up
+ * with OrderFaces.
+ */
+void ProjectObject3D(Object3D *object, short cx, short cy);
+
+/*
+ * Clipping works on vertices transformed to camera space with Transform3D.
+ * UpdateClipFlags stores outcodes in vertexFlags and returns them or'ed
+ * together, so if it returns zero the object is entirely visible.
+ *
+ * ClipFace3D returns CLIP_INSIDE if face needs no clipping, zero if it is
+ * outside of the frustum, or the size of clipped polygon (with first vertex
+ * repeated at the end) that is stored in *outp till the next call.
+ */
+#define CLIP_INSIDE -1
+
+u_char UpdateClipFlags(Object3D *object);
+short ClipFace3D(Object3D *object, short index, Point3D **outp);
+
+/* 3D scene graph */
+
+#define NODE_DIRTY 1 /* set when rotate, scale or translate was changed */
+#define NODE_MOVED 2 /* world transformation changed during last update */
+
+typedef struct Node3D {
+  struct Node3D *parent;
+  struct Node3D *child;  /* first child */
+  struct Node3D *next;   /* next sibling */
+  Object3D *object;      /* NULL for nodes that only group others */
+
+  Point3D rotate;
+  Point3D scale;         /* 4.12, magnitude above 1/8 (0x200) for localInv */
+  Point3D translate;
+
+  Matrix3D local;        /* node -> parent transformation */
+  Matrix3D localInv;     /* parent -> node rotation and scaling */
+  Matrix3D world;        /* node -> world transformation */
+  Matrix3D worldInv;     /* world -> node rotation and scaling */
+  u_short flags;
+} Node3D;
+
+typedef struct {
+  Point3D rotate;
+  Point3D translate;     /* position in world space */
+  short cx, cy;          /* center of projection on screen */
+  Matrix3D worldToCamera;
+  u_short flags;
+} Camera3D;
+
+/*
+ * Visible faces of all objects are sorted together. Index of each item
+ * refers both to an object and its face.
+ */
+#define SCENE_FACE_BITS 10
+#define SCENE_FACE_MASK ((1 << SCENE_FACE_BITS) - 1)
+
+typedef struct {
+  Node3D *root;
+  Camera3D camera;
+
+  short objects;
+  Object3D **object;     /* objects in order of graph traversal */
+  SortItemT *visibleFace;
+  SortItemT *sortBuffer;
+  short visibleFaces;
+} Scene3D;
+
+static inline Object3D *SceneFaceObject(Scene3D *scene, short index) {
+  return scene->object[(u_short)index >> SCENE_FACE_BITS];
+}
+
+static inline short SceneFaceIndex(short index) {
+  return index & SCENE_FACE_MASK;
+}
+
+Node3D *NewNode3D(Object3D *object);
+void DeleteNode3D(Node3D *node);
+void AddNode3D(Node3D *parent, Node3D *child);
+
+/* Call when the graph is complete. Nodes are not owned by the scene. */
+Scene3D *NewScene3D(Node3D *root);
+void DeleteScene3D(Scene3D *scene);
+void UpdateScene3D(Scene3D *scene);
 
 #endif
@@ -29,6 +29,37 @@ typedef struct Bitmap {
   void *planes[BM_NPLANES];
 } BitmapT;
 
+/* Distance between consecutive rows of a bitplane. Interleaved bitmaps store
+ * rows of all bitplanes one after another. */
+static inline short BitmapStride(const BitmapT *bitmap) {
+  if (bitmap->flags & BM_INTERLEAVED)
+    return (short)bitmap->bytesPerRow * (short)bitmap->depth;
+  return bitmap->bytesPerRow;
+}
+
+/* Interleaved bitmap seen as a single bitplane with 'depth' times as many rows,
+ * so that an operation on all bitplanes can be done with a single blit. */
+static inline void InitFlatBitmap(BitmapT *flat, const BitmapT *bitmap) {
+  /* Deep bitmaps may take more than 64KiB, which bplSize cannot hold. Blits
+   * on the view use its rows only, scratchpad gets the full offset. */
+  u_int size = (u_int)bitmap->bplSize * bitmap->depth;
+
+  flat->width = bitmap->width;
+  flat->height = bitmap->height * bitmap->depth;
+  flat->depth = 1;
+  flat->bytesPerRow = bitmap->bytesPerRow;
+  flat->bplSize = size;
+  flat->flags = bitmap->flags & ~BM_INTERLEAVED;
+  flat->planes[0] = bitmap->planes[0];
+  flat->planes[1] = bitmap->planes[0] + size;
+}
+
+/* Bitmaps have the same interleaved layout, so their flat views match. */
+static inline bool BitmapsInterleaved(const BitmapT *a, const BitmapT *b) {
+  return ((a->flags & b->flags & BM_INTERLEAVED) && a->depth == b->depth)
+    ? true : false;
+}
+
 u_int BitmapSize(BitmapT *bitmap);
 void BitmapSetPointers(BitmapT *bitmap, void *planes);
 
@@ -4,6 +4,7 @@
 #include <gfx.h>
 #include <2d.h>
 #include <custom.h>
+#include <copper.h>
 
 /* definitions for blitter control register 0 */
 #define ABC __BIT(7)
@@ -70,6 +71,10 @@
 #define LINE_SOLID 0
 #define LINE_ONEDOT 2
 
+/* Blits can be at most that many rows high. This limits single blits on flat
+ * views of interleaved bitmaps (see InitFlatBitmap). */
+#define BLIT_MAXROWS 1024
+
 /* Precalculated masks for bltafwm and bltalwm registers. */
 extern const u_short FirstWordMask[16];
 extern const u_short LastWordMask[16];
@@ -88,10 +93,63 @@ static inline void _WaitBlitter(CustomPtrT custom_) {
 
 #define WaitBlitter() _WaitBlitter(custom)
 
+/*
+ * Blit queue. Register values of each blit are calculated up front and the
+ * blitter interrupt feeds them to the blitter one after another, so the CPU
+ * does not have to wait for a blit to finish before it can start next one.
+ *
+ * Enqueuing returns a fence, i.e. sequence number of the blit. The CPU must
+ * wait for a fence before it uses memory that the blit writes. Blitter must
+ * not be used directly until BlitQueueSync returns.
+ *
+ * A blit can be enqueued with a callback, which the interrupt handler calls
+ * right after the blit has finished and the next one was started.
+ */
+#define BLITQ_SIZE 32
+
+typedef struct BlitCmd {
+  u_short bltcon0, bltcon1;
+  u_short bltafwm, bltalwm;
+  void *bltcpt, *bltbpt, *bltapt, *bltdpt;
+  u_short bltcmod, bltbmod, bltamod, bltdmod;
+  u_short bltcdat, bltbdat, bltadat;
+  u_short bltsize;
+} BlitCmdT;
+
+typedef void (*BlitNotifyT)(void *data);
+
+void InitBlitQueue(void);
+void KillBlitQueue(void);
+u_short BlitQueueAddNotify(const BlitCmdT *cmd, BlitNotifyT notify,
+                           void *data);
+#define BlitQueueAdd(cmd) BlitQueueAddNotify((cmd), NULL, NULL)
+bool BlitQueueDone(u_short fence);
+void BlitQueueWait(u_short fence);
+void BlitQueueSync(void);
+
+/*
+ * Writes all values of copper list patch with the blitter. Values must be in
+ * chip memory and the list must not be the one being displayed.
+ */
+const BlitCmdT *CopPatchCmd(const CopPatchT *patch, short n);
+
+#define CopPatchQueue(patch, n) BlitQueueAdd(CopPatchCmd((patch), (n)))
+
+/*
+ * Setup functions only calculate register values, which are loaded into the
+ * blitter by Start functions. Cmd functions return complete register set of
+ * a blit, which stays valid till next call of the same operation. It can be
+ * put into the blit queue (Queue macros).
+ */
+
 /* Blitter copy. */
 void BlitterCopySetup(const BitmapT *dst, u_short x, u_short y,
                       const BitmapT *src);
 void BlitterCopyStart(short dstbpl, short srcbpl);
+const BlitCmdT *BlitterCopyCmd(short dstbpl, short srcbpl);
+
+#define BlitterCopyQueue(dstbpl, srcbpl) \
+  BlitQueueAdd(BlitterCopyCmd((dstbpl), (srcbpl)))
 
 #define BlitterCopy(dst, dstbpl, x, y, src, srcbpl) ({  \
   BlitterCopySetup((dst), (x), (y), (src));             \
@@ -102,6 +160,10 @@ void BlitterCopyStart(short dstbpl, short srcbpl);
 void BlitterCopyAreaSetup(const BitmapT *dst, u_short x, u_short y,
                           const BitmapT *src, const Area2D *area);
 void BlitterCopyAreaStart(short dstbpl, short srcbpl);
+const BlitCmdT *BlitterCopyAreaCmd(short dstbpl, short srcbpl);
+
+#define BlitterCopyAreaQueue(dstbpl, srcbpl) \
+  BlitQueueAdd(BlitterCopyAreaCmd((dstbpl), (srcbpl)))
 
 #define BlitterCopyArea(dst, dstbpl, x, y, src, srcbpl, area) ({        \
   BlitterCopyAreaSetup((dst), (x), (y), (src), (area));                 \
@@ -112,11 +174,19 @@ void BlitterCopyAreaStart(short dstbpl, short srcbpl);
 void BlitterCopyFastSetup(const BitmapT *dst, u_short x, u_short y,
                           const BitmapT *src);
 void BlitterCopyFastStart(short dstbpl, short srcbpl);
+const BlitCmdT *BlitterCopyFastCmd(short dstbpl, short srcbpl);
+
+#define BlitterCopyFastQueue(dstbpl, srcbpl) \
+  BlitQueueAdd(BlitterCopyFastCmd((dstbpl), (srcbpl)))
 
 /* Blitter copy masked. */
 void BlitterCopyMaskedSetup(const BitmapT *dst, u_short x, u_short y,
                             const BitmapT *src, const BitmapT *msk);
 void BlitterCopyMaskedStart(short dstbpl, short srcbpl);
+const BlitCmdT *BlitterCopyMaskedCmd(short dstbpl, short srcbpl);
+
+#define BlitterCopyMaskedQueue(dstbpl, srcbpl) \
+  BlitQueueAdd(BlitterCopyMaskedCmd((dstbpl), (srcbpl)))
 
 /* Bitmap copy. */
 void BitmapCopy(const BitmapT *dst, u_short x, u_short y, const BitmapT *src);
@@ -127,11 +197,17 @@ void BitmapCopyMasked(const BitmapT *dst, u_short x, u_short y,
 void BitmapCopyArea(const BitmapT *dst, u_short dx, u_short dy, 
                     const BitmapT *src, const Area2D *area);
 
-/* Blitter fill. */
-void BlitterFillArea(const BitmapT *bitmap, short plane, const Area2D *area);
+/* Blitter fill, 'mode' is FILL_OR (inclusive) or FILL_XOR (exclusive). */
+void BlitterFillArea(const BitmapT *bitmap, short plane, const Area2D *area,
+                     u_short mode);
+const BlitCmdT *BlitterFillAreaCmd(const BitmapT *bitmap, short plane,
+                                   const Area2D *area, u_short mode);
+
+#define BlitterFillAreaQueue(bitmap, plane, area, mode) \
+  BlitQueueAdd(BlitterFillAreaCmd((bitmap), (plane), (area), (mode)))
 
 #define BlitterFill(bitmap, plane) \
-  BlitterFillArea((bitmap), (plane), NULL)
+  BlitterFillArea((bitmap), (plane), NULL, FILL_OR)
 
 /* Blitter clear. */
 #define BlitterClear(bitmap, plane) \
@@ -147,6 +223,10 @@ void BlitterFillArea(const BitmapT *bitmap, short plane, const Area2D *area);
 /* Blitter set. */
 void BlitterSetAreaSetup(const BitmapT *bitmap, const Area2D *area);
 void BlitterSetAreaStart(short bplnum, u_short pattern);
+const BlitCmdT *BlitterSetAreaCmd(short bplnum, u_short pattern);
+
+#define BlitterSetAreaQueue(bplnum, pattern) \
+  BlitQueueAdd(BlitterSetAreaCmd((bplnum), (pattern)))
 
 void BlitterSetMaskArea(const BitmapT *bitmap, short plane, u_short x, u_short y,
                         const BitmapT *mask, const Area2D *area, u_short pattern);
@@ -175,6 +255,33 @@ void BlitterLineSetupFull(const BitmapT *bitmap, u_short plane,
 void BlitterLine(short x1 asm("d2"), short y1 asm("d3"),
                  short x2 asm("d4"), short y2 asm("d5"));
 
+/*
+ * Line batches. Register values of all lines are calculated up front for
+ * bitmap, plane and mode given to BlitterLineSetup, then streamed to the
+ * blitter. BlitterLineQueue returns fence of the last line, so 'n' must be
+ * positive.
+ */
+typedef struct LineCmd {
+  u_short bltcon0, bltcon1;
+  u_short bltamod, bltbmod;
+  void *bltapt, *bltcpt, *bltdpt;
+  u_short bltsize;
+} LineCmdT;
+
+void BlitterLinePrepare(LineCmdT *cmd, const Line2D *lines, short n);
+
+/*
+ * Edges are taken the way lib3d stores them in MeshT: 'p0' and 'p1' are byte
+ * offsets into 'point' array, whose entries start with x and y (i.e. Point3D
+ * vertices of Object3D). Edges with zero in 'flags' are skipped, NULL takes
+ * all of them. Returns number of prepared lines.
+ */
+short BlitterLinePrepareEdges(LineCmdT *cmd, const void *point,
+                              const EdgeT *edge, const char *flags, short n);
+
+void BlitterLineBatch(const LineCmdT *cmd, short n);
+u_short BlitterLineQueue(const LineCmdT *cmd, short n);
+
 /* Other operations. */
 void BitmapAddSaturated(const BitmapT *dst, short dx, short dy,
                         const BitmapT *src, const BitmapT *carry);
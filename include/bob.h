@@ -0,0 +1,40 @@
+#ifndef __BOB_H__
+#define __BOB_H__
+
+#include "gfx.h"
+
+/*
+ * Bobs are drawn into a double buffered screen with cookie-cut blits. Each bob
+ * remembers area it covered in each buffer, so BobsRestore copies back from
+ * background only what was overdrawn when the buffer was used last time.
+ * Areas that overlap are merged, if it does not make blitter do more work.
+ *
+ * Masks are made by BitmapMakeMask. A bob without mask is or'ed into screen
+ * instead, so overlapping bobs blend. If screen and bob image are interleaved,
+ * each bob is drawn with a single blit.
+ * Bobs are clipped to screen with word masks. Shifted bobs that stick out on
+ * both sides of the screen are not drawn.
+ */
+#define BOB_BUFFERS 2
+
+typedef struct Bob {
+  const BitmapT *bitmap;
+  const BitmapT *mask; /* NULL to draw with or */
+  short x, y;
+  bool visible;
+  Area2D dirty[BOB_BUFFERS]; /* area covered in each buffer, h = 0 if none */
+} BobT;
+
+typedef struct Bobs {
+  const BitmapT *background;
+  short count;
+  BobT *bob;
+  Area2D *area; /* for merging dirty areas */
+} BobsT;
+
+BobsT *NewBobs(const BitmapT *background, short count);
+void DeleteBobs(BobsT *bobs);
+void BobsRestore(BobsT *bobs, const BitmapT *screen, short buffer);
+void BobsDraw(BobsT *bobs, const BitmapT *screen, short buffer);
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef __C2P_H__
+#define __C2P_H__
+
+#include "common.h"
+
+/*
+ * Blitter chunky to planar conversion is a sequence of passes. Each one merges
+ * two words, shifted by at most one of the channels, under a constant mask:
+ *
+ *   D = ((A shifted) & mask) | ((B shifted) & ~mask)
+ *
+ * Mask goes through bltcdat. Bits that shifter carries over from neighbouring
+ * word always land where mask clears them, so the passes give the same results
+ * as word by word models in prototypes/c2p. Shifts to the left are done with
+ * blitter running in descending mode.
+ *
+ * Layouts describe passes in terms of chunky buffer size N (in words):
+ *  - chunky buffer of N words is an input, but it is clobbered by the passes,
+ *  - temporary buffer of N words holds intermediate results,
+ *  - each output buffer gets 'size' quarters of N words.
+ */
+
+/* Buffers read or written by a pass. */
+#define C2P_NONE 0
+#define C2P_CHUNKY 1
+#define C2P_TEMP 2
+#define C2P_OUTPUT(i) (3 + (i))
+
+#define C2P_MAXOUTPUTS 4
+
+typedef struct C2PChannel {
+  u_char buf;     /* one of C2P_* above */
+  u_char quarter; /* buffer offset in quarters of N words */
+  short start;    /* further offset in words */
+  short modulo;   /* in words */
+} C2PChannelT;
+
+typedef struct C2PPass {
+  C2PChannelT a, b, d;
+  u_short mask;
+  u_char ashift, bshift;
+  bool left;      /* shift to the left, i.e. blit in descending mode */
+  u_char width;   /* in words */
+  u_char step;    /* number of rows is N / step */
+} C2PPassT;
+
+typedef struct C2PLayout {
+  const char *name;
+  const char *format; /* description of expected chunky buffer contents */
+  short passes;
+  short outputs;
+  short size;         /* size of each output buffer in quarters of N words */
+  bool local;         /* any 4-word aligned part of chunky buffer can be
+                       * converted on its own, i.e. all quarters are 0 */
+  const C2PPassT *pass;
+} C2PLayoutT;
+
+extern const C2PLayoutT C2PLayout1x1x4;
+extern const C2PLayoutT C2PLayout1x1x4Mangled;
+extern const C2PLayoutT C2PLayout1x1Ham6Mangled;
+extern const C2PLayoutT C2PLayout2x1x4Mangled;
+extern const C2PLayoutT C2PLayout2x1x4MangledFast;
+
+/* Layouts terminated with NULL, for tools that go through all of them. */
+extern const C2PLayoutT *C2PLayouts[];
+
+static inline int C2PRows(const C2PPassT *pass, int words) {
+  return words / pass->step;
+}
+
+/*
+ * Offset in words of the first word transferred through a channel. In
+ * descending mode that is the last word of the area covered by the pass.
+ */
+static inline int C2PChannelOffset(const C2PPassT *pass,
+                                   const C2PChannelT *channel, int words)
+{
+  int offset = channel->quarter * (words >> 2) + channel->start;
+  if (pass->left)
+    offset += (C2PRows(pass, words) - 1) * (pass->width + channel->modulo) +
+              pass->width - 1;
+  return offset;
+}
+
+/* Run passes of the layout with the CPU, e.g. for the CPU part of split
+ * mode. Output buffers are given in 'output' array. */
+void C2PLayoutConvert(const C2PLayoutT *layout, u_short *chunky,
+                      u_short *temp, u_short **output, int words);
+
+/*
+ * Blitter driven conversion. Blits are precomputed by C2PSetBuffers and
+ * issued through blitter queue (see InitBlitQueue), which calls 'done' from
+ * the interrupt handler when the last one has finished. C2PStart waits till
+ * previous conversion is done.
+ *
+ * In split mode chunky buffer is divided in two parts. Blitter converts the
+ * first one, while CPU converts the remaining 'cpuWords' words in C2PStart.
+ * That works only for layouts marked as local.
+ */
+typedef void (*C2PDoneT)(void *data);
+
+struct C2P;
+typedef struct C2P C2PT;
+
+C2PT *NewC2P(const C2PLayoutT *layout, int words);
+void DeleteC2P(C2PT *c2p);
+void C2PSetSplit(C2PT *c2p, int cpuWords);
+void C2PSetBuffers(C2PT *c2p, void *chunky, void *temp, void **output);
+u_short C2PStart(C2PT *c2p, C2PDoneT done, void *data);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef __CHUNKFILE_H__
+#define __CHUNKFILE_H__
+
+#include <file.h>
+
+/*
+ * Container of independently compressed chunks produced by
+ * tools/chunkpack.py. Any chunk can be fetched by its index, so large assets
+ * (e.g. animation frames) can be streamed without loading them whole.
+ */
+
+#define CHUNK_STORED 0
+#define CHUNK_LZ4 1
+#define CHUNK_DEFLATE 2
+
+typedef struct {
+  u_int offset;   /* position of chunk data in container (2-byte aligned) */
+  u_int length;   /* chunk size after decompression */
+  u_short method; /* one of CHUNK_* constants */
+  u_short pad;
+} ChunkT;
+
+typedef struct {
+  FileT *file;
+  short count;
+  u_int maxSize;   /* size of the largest chunk as stored */
+  u_int maxLength; /* size of the largest chunk after decompression */
+  void *packed;    /* buffer for compressed chunk data */
+  ChunkT chunk[0]; /* count + 1 entries, the last one marks end of data */
+} ChunkFileT;
+
+/* Takes over the file, which will be closed with the container. */
+ChunkFileT *ChunkFileOpen(FileT *file);
+void ChunkFileClose(ChunkFileT *cf);
+
+/* Reads and decompresses a chunk. Returns its length or an error code. */
+int ChunkRead(ChunkFileT *cf, short num, void *buf);
+/* Allocates memory for a chunk and reads it. */
+void *ChunkLoad(ChunkFileT *cf, short num, u_int memoryFlags);
+
+static inline u_int ChunkLength(ChunkFileT *cf, short num) {
+  return cf->chunk[num].length;
+}
+
+#endif
@@ -44,6 +44,20 @@
   } \
 }
 
+static inline short absw(short a) {
+  if (a < 0)
+    return -a;
+  return a;
+}
+
+static inline u_short swap8(u_short a) {
+  return (a << 8) | (a >> 8);
+}
+
+#define rorw(a, b) \
+  (((a) << (16 - (b))) | ((a) >> (b)))
+
+#ifdef __mc68000__
 /* assumes that abs(idx) < 32768 */
 static inline short getword(void *tab, short idx) {
   short res;
@@ -67,21 +81,11 @@ static inline int getlong(void *tab, short idx) {
   return res;
 }
 
-static inline short absw(short a) {
-  if (a < 0)
-    return -a;
-  return a;
-}
-
 static inline u_int swap16(u_int a) {
   asm("swap %0": "+d" (a));
   return a;
 }
 
-static inline u_short swap8(u_short a) {
-  return (a << 8) | (a >> 8);
-}
-
 static inline short div16(int a, short b) {
   short r;
   asm("divs %2,%0"
@@ -110,8 +114,8 @@ static inline int mul16(short a, short b) {
 /* _n:int / _d:short -> _q:short (quotient), _r:short (remainder) */ 
 #define divmod16(_n, _d, _q, _r)                                               \
   asm("divs %3,%0\n"                                                           \
-      "move.w %0,%1\n"                                                         \
-      "swap %0\n"                                                              \
+      "move.l %0,%1\n"                                                         \
+      "swap %1\n"                                                              \
       : "=d" (_q), "=d" (_r)                                                   \
       : "0" (_n), "d" (_d));
 
@@ -127,9 +131,6 @@ static inline void bchg(u_char *ptr, char bit) {
   asm("bchg %1,%0" :: "m" (*ptr), "dI" (bit));
 }
 
-#define rorw(a, b) \
-  (((a) << (16 - (b))) | ((a) >> (b)))
-
 #define swapr(a, b) \
   asm ("exg %0,%1" : "+r" (a), "+r" (b))
 
@@ -144,5 +145,52 @@ static inline void *GetSP(void) {
   asm("movel sp,%0" : "=r" (sp));
   return sp;
 }
+#else
+/*
+ * Portable versions for host builds (see tools/host3d). They must give the
+ * same results as instructions above for arguments that m68k code can pass,
+ * e.g. div16 quotient must fit in a word.
+ */
+static inline short getword(void *tab, short idx) {
+  return ((short *)tab)[idx];
+}
+
+static inline int getlong(void *tab, short idx) {
+  return ((int *)tab)[idx];
+}
+
+static inline u_int swap16(u_int a) {
+  return (a << 16) | (a >> 16);
+}
+
+static inline short div16(int a, short b) {
+  return a / b;
+}
+
+static inline short mod16(int a, short b) {
+  return a % b;
+}
+
+static inline int mul16(short a, short b) {
+  return a * b;
+}
+
+#define divmod16(_n, _d, _q, _r)                                               \
+  { int _t = (_n); short _u = (_d); _q = _t / _u; _r = _t % _u; }
+
+static inline void bclr(u_char *ptr, char bit) {
+  *ptr &= ~(1 << (bit & 7));
+}
+
+static inline void bset(u_char *ptr, char bit) {
+  *ptr |= 1 << (bit & 7);
+}
+
+static inline void bchg(u_char *ptr, char bit) {
+  *ptr ^= 1 << (bit & 7);
+}
+
+#define swapr(a, b) swap(a, b)
+#endif
 
 #endif
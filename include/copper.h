@@ -1,6 +1,7 @@
 #ifndef __COPPER_H__
 #define __COPPER_H__
 
+#include <debug.h>
 #include <gfx.h>
 #include <playfield.h>
 
@@ -34,13 +35,15 @@ typedef union {
   } move;
 } CopInsT;
 
-typedef struct {
+typedef struct CopList {
   CopInsT *curr;
   u_short length;
   u_char  overflow; /* -1 if Vertical Position counter overflowed */
   CopInsT entry[0]; 
 } CopListT;
 
+/* Lists that do not change their shape can be compiled into static data by
+ * tools/cop2c.py instead, such lists must not be passed to DeleteCopList. */
 CopListT *NewCopList(u_short length);
 void DeleteCopList(CopListT *list);
 
@@ -49,8 +52,15 @@ static inline void CopInit(CopListT *list) {
   list->overflow = 0;
 }
 
+/* In debug build builders check that 'n' more instructions fit into the list
+ * before they write anything. */
+static inline void CopCheck(CopListT *list, short n) {
+  Assert(list->curr + n <= list->entry + list->length);
+}
+
 static inline void CopEnd(CopListT *list) {
   CopInsT *ins = list->curr;
+  CopCheck(list, 1);
   *((u_int *)ins)++ = 0xfffffffe;
   list->curr = ins;
 }
@@ -72,6 +82,7 @@ static inline void CopListRun(CopListT *list) {
 static inline CopInsT *CopMoveWord(CopListT *list, short reg, short data) {
   CopInsT *pos = list->curr;
   CopInsT *ins = list->curr;
+  CopCheck(list, 1);
   *((u_short *)ins)++ = reg;
   *((u_short *)ins)++ = data;
   list->curr = ins;
@@ -85,6 +96,7 @@ static inline void CopInsSet16(CopInsT *ins, short data) {
 static inline CopInsT *CopMoveLong(CopListT *list, short reg, int data) {
   CopInsT *pos = list->curr;
   CopInsT *ins = list->curr;
+  CopCheck(list, 2);
   *((u_short *)ins)++ = reg + 2;
   *((u_short *)ins)++ = data;
   *((u_short *)ins)++ = reg;
@@ -108,6 +120,7 @@ static inline void CopInsSet32(CopInsT *ins, void *data) {
 static inline CopInsT *CopWait(CopListT *list, short vp, short hp) {
   CopInsT *pos = list->curr;
   CopInsT *ins = list->curr;
+  CopCheck(list, 1);
   *((u_char *)ins)++ = vp;
   *((u_char *)ins)++ = hp | 1;
   *((u_short *)ins)++ = 0xfffe;
@@ -120,6 +133,7 @@ static inline CopInsT *CopWait(CopListT *list, short vp, short hp) {
 static inline CopInsT *CopWaitSafe(CopListT *list, short vp, short hp) {
   CopInsT *pos = list->curr;
   CopInsT *ins = list->curr;
+  CopCheck(list, (vp > 255 && !list->overflow) ? 2 : 1);
   if (vp > 255 && !list->overflow) {
     list->overflow = -1;
     /* Wait for last waitable position to control when overflow occurs. */
@@ -137,6 +151,7 @@ static inline CopInsT *CopWaitMask(CopListT *list, short vp, short hp,
                                    short vpmask, short hpmask) {
   CopInsT *pos = list->curr;
   CopInsT *ins = list->curr;
+  CopCheck(list, 1);
   *((u_char *)ins)++ = vp;
   *((u_char *)ins)++ = hp | 1;
   *((u_char *)ins)++ = 0x80 | vpmask;
@@ -155,6 +170,7 @@ static inline CopInsT *CopWaitMask(CopListT *list, short vp, short hp,
 static inline CopInsT *CopSkip(CopListT *list, short vp, short hp) {
   CopInsT *pos = list->curr;
   CopInsT *ins = list->curr;
+  CopCheck(list, 1);
   *((u_char *)ins)++ = vp;
   *((u_char *)ins)++ = hp | 1;
   *((u_short *)ins)++ = 0xffff;
@@ -167,6 +183,7 @@ static inline CopInsT *CopSkipMask(CopListT *list, short vp, short hp,
                                    short vpmask, short hpmask) {
   CopInsT *pos = list->curr;
   CopInsT *ins = list->curr;
+  CopCheck(list, 1);
   *((u_char *)ins)++ = vp;
   *((u_char *)ins)++ = hp | 1;
   *((u_char *)ins)++ = 0x80 | vpmask;
@@ -199,4 +216,29 @@ static inline CopInsT *CopSetColor(CopListT *list, short i, short value) {
   return CopMove16(list, color[i], value);
 }
 
+/*
+ * Copper list patches. A patch is an array of values taken by MOVE
+ * instructions in each of two copper lists, e.g. a color of each line. Lists
+ * are built once, then each frame the effect fills in values and the list
+ * that is not displayed gets patched. CopPatchUpdate compares values with
+ * a copy of what is in the list and writes only those that have changed, so
+ * the CPU does not touch chip memory at all for unchanged ones. If MOVEs are
+ * evenly spaced the blitter can write all values instead (see CopPatchCmd).
+ */
+typedef struct CopPatch {
+  short count;
+  short stride;       /* in instructions, 0 if MOVEs are not evenly spaced */
+  short *value;       /* values to be written by next update */
+  short *shadow[2];   /* values currently stored in each list */
+  CopInsT **ins[2];   /* MOVE instructions of each list */
+} CopPatchT;
+
+/* Values must be in chip memory to be written by the blitter. */
+CopPatchT *NewCopPatch(short count, u_int memFlags);
+void DeleteCopPatch(CopPatchT *patch);
+/* Tell that MOVE instruction 'ins' of list 'n' takes i-th value. Bind first
+ * list first and values in ascending order. */
+void CopPatchBind(CopPatchT *patch, short n, short i, CopInsT *ins);
+void CopPatchUpdate(CopPatchT *patch, short n);
+
 #endif
@@ -3,12 +3,17 @@
 
 #include <cdefs.h>
 
+#ifdef __mc68000__
 /* When simulator is configured to enter debugger on illegal instructions,
  * this macro can be used to set breakpoints in your code. */
 #define BREAK() { asm volatile("\tillegal\n"); }
 
 /* Halt the processor by masking all interrupts and waiting for NMI. */
 #define HALT() { asm volatile("\tstop\t#0x2700\n"); }
+#else
+#define BREAK() { __builtin_trap(); }
+#define HALT() { __builtin_trap(); }
+#endif
 
 /* Use whenever a program should generate a fatal error. This will break into
  * debugger for program inspection and stop instruction execution. */
@@ -9,6 +9,7 @@
 #define SEEK_END 2
 
 #define O_NONBLOCK 1
+#define O_BINARY 2 /* no end-of-line translation */
 
 typedef struct File FileT;
 
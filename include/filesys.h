@@ -12,4 +12,8 @@ void *LoadFile(const char *path, u_int memoryFlags);
 void InitFileSys(void);
 void KillFileSys(void);
 
+/* Files served by tools/remotefs.py over serial port. */
+FileT *RemoteOpen(const char *path);
+int RemoteFileSize(const char *path);
+
 #endif
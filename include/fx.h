@@ -17,6 +17,7 @@ static inline short COS(short a) {
   return getword(sintab, (a + SIN_HALF_PI) & SIN_MASK);
 }
 
+#ifdef __mc68000__
 static inline short normfx(int a) {
   asm("lsll #4,%0\n"
       "swap %0\n"
@@ -32,6 +33,15 @@ static inline int shift12(short a) {
       : "=d" (b) : "0" (a));
   return b;
 }
+#else
+static inline short normfx(int a) {
+  return a >> 12;
+}
+
+static inline int shift12(short a) {
+  return a * 4096;
+}
+#endif
 
 #define fx4i(i) \
   (short)((u_short)(i) << 4)
@@ -1,6 +1,6 @@
 #ifndef __INFLATE_H__
 #define __INFLATE_H__
 
-void Inflate(const void *input asm("a4"), void *output asm("a5"));
+void Inflate(const void *input asm("a5"), void *output asm("a4"));
 
 #endif
@@ -7,6 +7,7 @@
  * https://sourceware.org/gdb/onlinedocs/stabs/Non_002dStab-Symbol-Types.html
  */
 
+#ifdef __mc68000__
 /* Add symbol 's' to list 'l' (type 't': 22=text, 24=data, 26=bss). */
 #define ADD2LIST(s, l, t) \
   asm(".stabs \"_" #l "\"," #t ",0,0,_" #s )
@@ -27,5 +28,15 @@
 /* Make symbol alias from a to b. */
 #define ALIAS(a,b) \
   asm(".stabs \"_" #a "\",11,0,0,0;.stabs \"_" #b "\",1,0,0,0")
+#else
+/* Host builds (see tools/host3d) only need constructors and destructors. */
+#define ADD2INIT(ctor, pri) \
+  __attribute__((constructor(1000 + pri))) \
+  static void ctor##_host(void) { ctor(); }
+
+#define ADD2EXIT(dtor, pri) \
+  __attribute__((destructor(1000 + pri))) \
+  static void dtor##_host(void) { dtor(); }
+#endif
 
 #endif
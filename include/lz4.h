@@ -0,0 +1,11 @@
+#ifndef __LZ4_H__
+#define __LZ4_H__
+
+/*
+ * Decompress a stream produced by tools/lz4pack.py. Returns pointer to the
+ * first byte past decompressed data. Several times faster than Inflate,
+ * at a cost of worse compression ratio.
+ */
+void *Lz4Unpack(const void *input asm("a0"), void *output asm("a1"));
+
+#endif
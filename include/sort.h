@@ -9,4 +9,10 @@ typedef struct {
 
 void SortItemArray(SortItemT *table, short size);
 
+/*
+ * Stable sort that takes time linear in table size. Requires temporary
+ * array of the same size. Result is stored in the original table.
+ */
+void RadixSortItemArray(SortItemT *table, SortItemT *temp, short size);
+
 #endif
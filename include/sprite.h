@@ -108,4 +108,34 @@ static inline void CopInsSetSprite(CopInsT *sprptr, SpriteT *spr) {
   CopInsSet32(sprptr, spr->sprdat);
 }
 
+/*
+ * Sprite multiplexer shows more than eight sprites by reusing DMA channels
+ * vertically. Each frame logical sprites are sorted by vertical position and
+ * assigned to channels, then their control words and pixel data are copied
+ * into chained sprite data of the channels (see the picture above).
+ *
+ * A channel can start next sprite one line after previous one has ended. An
+ * attached sprite takes a pair of channels, i.e. 0 & 1, 2 & 3 and so on.
+ * Sprites that do not fit anywhere are left out.
+ */
+typedef struct MuxSprite {
+  SpriteT *sprite[2]; /* second one is NULL or attached to the first one */
+  short x, y;         /* as in SpriteUpdatePos */
+} MuxSpriteT;
+
+struct SpriteMux;
+typedef struct SpriteMux SpriteMuxT;
+
+/* `lines` is the number of lines sprites of a frame can span at most. */
+SpriteMuxT *NewSpriteMux(short maxSprites, short lines);
+void DeleteSpriteMux(SpriteMuxT *mux);
+
+/*
+ * Builds sprite data for next frame and sets up sprite pointers in the copper
+ * list. Data is double buffered, so call it at most once per frame. Returns
+ * number of sprites that were left out.
+ */
+short SpriteMuxBuild(SpriteMuxT *mux, MuxSpriteT *sprite, short count,
+                     CopInsT **sprptr);
+
 #endif
@@ -3,6 +3,7 @@
 
 #include <types.h>
 
+#ifdef __mc68000__
 void *memmove(void *dst asm("a1"), const void *src asm("a0"),
               size_t len asm("d1"));
 void *memset(void *b asm("a0"), int c asm("d0"), size_t len asm("d1"));
@@ -13,5 +14,15 @@ int strcmp(const char *s1 asm("a0"), const char *s2 asm("a1"));
 size_t strlen(const char *s asm("a0"));
 
 size_t strlcpy(char *__restrict dst, const char *__restrict src, size_t siz);
+#else
+void *memmove(void *dst, const void *src, size_t len);
+void *memset(void *b, int c, size_t len);
+void *memcpy(void *__restrict dst, const void *__restrict src, size_t n);
+char *strcpy(char *dst, const char *src);
+int strcmp(const char *s1, const char *s2);
+size_t strlen(const char *s);
+
+size_t strlcpy(char *__restrict dst, const char *__restrict src, size_t siz);
+#endif
 
 #endif
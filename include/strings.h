@@ -3,8 +3,13 @@
 
 #include <types.h>
 
+#ifdef __mc68000__
 void bcopy(const void *src asm("a0"), void *dst asm("a1"),
            size_t len asm("d1"));
 void bzero(void *s asm("a0"), size_t n asm("d1"));
+#else
+void bcopy(const void *src, void *dst, size_t len);
+void bzero(void *s, size_t n);
+#endif
 
 #endif
@@ -0,0 +1,8 @@
+#include <3d.h>
+
+void AddNode3D(Node3D *parent, Node3D *child) {
+  child->parent = parent;
+  child->next = parent->child;
+  child->flags |= NODE_DIRTY;
+  parent->child = child;
+}
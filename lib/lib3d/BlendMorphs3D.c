@@ -0,0 +1,54 @@
+#include <string.h>
+#include <3d.h>
+#include <fx.h>
+
+/*
+ * Each morph target lists only vertices and face normals it moves. Targets
+ * with zero weight cost nothing and those at full weight take no
+ * multiplications, so animation that switches between targets is cheap.
+ * Scaled delta takes three multiplications per vertex (~250 cycles).
+ */
+
+static void AddDeltas(void *data, MorphDeltaT *delta, short n) {
+  while (--n >= 0) {
+    short *p = (short *)(data + delta->offset);
+    *p++ += delta->x;
+    *p++ += delta->y;
+    *p++ += delta->z;
+    delta++;
+  }
+}
+
+static void AddScaledDeltas(void *data, MorphDeltaT *delta, short n,
+                            short w)
+{
+  while (--n >= 0) {
+    short *p = (short *)(data + delta->offset);
+    *p++ += normfx(delta->x * w);
+    *p++ += normfx(delta->y * w);
+    *p++ += normfx(delta->z * w);
+    delta++;
+  }
+}
+
+void BlendMorphs3D(Mesh3D *mesh, Mesh3D *base, short *weight) {
+  MorphTargetT *morph = base->morph;
+  short n = base->morphs;
+
+  memcpy(mesh->vertex, base->vertex, sizeof(Point3D) * base->vertices);
+  memcpy(mesh->faceNormal, base->faceNormal, sizeof(Point3D) * base->faces);
+
+  while (--n >= 0) {
+    short w = *weight++;
+
+    if (w == fx12f(1.0)) {
+      AddDeltas(mesh->vertex, morph->vertex, morph->vertices);
+      AddDeltas(mesh->faceNormal, morph->faceNormal, morph->faces);
+    } else if (w) {
+      AddScaledDeltas(mesh->vertex, morph->vertex, morph->vertices, w);
+      AddScaledDeltas(mesh->faceNormal, morph->faceNormal, morph->faces, w);
+    }
+
+    morph++;
+  }
+}
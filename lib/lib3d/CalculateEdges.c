@@ -29,6 +29,9 @@ void CalculateEdges(Mesh3D *mesh) {
   ExtEdgeT *edge;
   short count, edges;
 
+  if (mesh->edge)
+    return;
+
   /* Count edges. */
   {
     IndexListT **faces = mesh->face;
@@ -149,4 +152,6 @@ void CalculateEdges(Mesh3D *mesh) {
   }
 
   MemFree(edge);
+
+  mesh->allocated |= MESH_EDGES;
 }
@@ -14,7 +14,11 @@
  */
 
 void CalculateFaceNormals(Mesh3D *mesh) {
+  if (mesh->faceNormal)
+    return;
+
   mesh->faceNormal = MemAlloc(sizeof(Point3D) * mesh->faces, MEMF_PUBLIC);
+  mesh->allocated |= MESH_FACE_NORMAL;
 
   {
     Point3D *vertex = mesh->vertex;
@@ -7,8 +7,12 @@
  * vertices, so this procedure calculates a reverse map.
  */
 void CalculateVertexFaceMap(Mesh3D *mesh) {
-  short *faceCount = MemAlloc(sizeof(short) * mesh->vertices,
-                             MEMF_PUBLIC|MEMF_CLEAR);
+  short *faceCount;
+
+  if (mesh->vertexFace)
+    return;
+
+  faceCount = MemAlloc(sizeof(short) * mesh->vertices, MEMF_PUBLIC|MEMF_CLEAR);
 
   /* 
    * Count the size of the { vertex => face } map and for each vertex a
@@ -70,4 +74,6 @@ void CalculateVertexFaceMap(Mesh3D *mesh) {
       i++;
     }
   }
-} 
+
+  mesh->allocated |= MESH_VERTEX_FACE;
+}
@@ -2,8 +2,12 @@
 #include <memory.h>
 
 void CalculateVertexNormals(Mesh3D *mesh) {
+  if (mesh->vertexNormal)
+    return;
+
   mesh->vertexNormal = MemAlloc(sizeof(Point3D) * mesh->vertices,
                                 MEMF_PUBLIC|MEMF_CLEAR);
+  mesh->allocated |= MESH_VERTEX_NORMAL;
 
   {
     short *normal = (short *)mesh->vertexNormal;
@@ -13,7 +17,8 @@ void CalculateVertexNormals(Mesh3D *mesh) {
     IndexListT *vertexFace;
 
     while ((vertexFace = *vertexFaces++)) {
-      short n = vertexFace->count;
+      short count = vertexFace->count;
+      short n = count;
       short *v = vertexFace->indices;
       int nx = 0;
       int ny = 0;
@@ -24,10 +29,15 @@ void CalculateVertexNormals(Mesh3D *mesh) {
         nx += *fn++; ny += *fn++; nz += *fn++;
       }
 
-      *normal++ = div16(nx, n);
-      *normal++ = div16(ny, n);
-      *normal++ = div16(nz, n);
-      normal++;
+      /* Vertices that do not belong to any face are left zeroed. */
+      if (count > 0) {
+        *normal++ = div16(nx, count);
+        *normal++ = div16(ny, count);
+        *normal++ = div16(nz, count);
+        normal++;
+      } else {
+        normal += 4;
+      }
     }
   }
 }
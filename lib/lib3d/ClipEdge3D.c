@@ -0,0 +1,50 @@
+#include <3d.h>
+
+/*
+ * Finds where segment from S to E crosses given plane. Distances of both
+ * points to the plane are measured so that they are positive inside of the
+ * frustum. Coordinate that lies on the plane is set exactly, so rounding
+ * errors never push the point outside.
+ */
+void ClipEdge3D(Point3D *o, Point3D *s, Point3D *e, u_short plane) {
+  short dx = e->x - s->x;
+  short dy = e->y - s->y;
+  short dz = e->z - s->z;
+  short ds, de;
+
+  if (plane & PF_LEFT) {
+    ds = s->x - s->z; de = e->x - e->z;
+  } else if (plane & PF_RIGHT) {
+    ds = -s->x - s->z; de = -e->x - e->z;
+  } else if (plane & PF_TOP) {
+    ds = s->y - s->z; de = e->y - e->z;
+  } else if (plane & PF_BOTTOM) {
+    ds = -s->y - s->z; de = -e->y - e->z;
+  } else if (plane & PF_NEAR) {
+    ds = ClipFrustum.near - s->z; de = ClipFrustum.near - e->z;
+  } else {
+    ds = s->z - ClipFrustum.far; de = e->z - ClipFrustum.far;
+  }
+
+  de = ds - de;
+
+  o->x = s->x + div16(dx * ds, de);
+  o->y = s->y + div16(dy * ds, de);
+
+  if (plane & PF_NEAR) {
+    o->z = ClipFrustum.near;
+  } else if (plane & PF_FAR) {
+    o->z = ClipFrustum.far;
+  } else {
+    o->z = s->z + div16(dz * ds, de);
+
+    if (plane & PF_LEFT)
+      o->x = o->z;
+    else if (plane & PF_RIGHT)
+      o->x = -o->z;
+    else if (plane & PF_TOP)
+      o->y = o->z;
+    else
+      o->y = -o->z;
+  }
+}
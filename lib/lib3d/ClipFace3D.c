@@ -0,0 +1,228 @@
+#include <debug.h>
+#include <3d.h>
+
+#define MAXPOLY 32
+
+/*
+ * Closed polygon being clipped, i.e. the first vertex is repeated at the end.
+ * Side is the number of mesh edge that starts at the vertex, or -1 if it is
+ * not a part of any edge, because it lies on a clipping plane.
+ */
+typedef struct {
+  Point3D point[MAXPOLY];
+  short side[MAXPOLY];
+  u_char code[MAXPOLY];
+} ClipPolyT;
+
+static ClipPolyT poly[2];
+
+/* Near and far planes go first, so no point behind the camera is left. */
+static const u_short ClipOrder[6] = {
+  PF_NEAR, PF_FAR, PF_LEFT, PF_RIGHT, PF_TOP, PF_BOTTOM
+};
+
+static inline u_char Outcode(Point3D *p) {
+  short x = p->x;
+  short y = p->y;
+  short z = p->z;
+  u_char f = 0;
+
+  if (x < z)
+    f |= PF_LEFT;
+  if (x > -z)
+    f |= PF_RIGHT;
+  if (y < z)
+    f |= PF_TOP;
+  if (y > -z)
+    f |= PF_BOTTOM;
+  if (z > ClipFrustum.near)
+    f |= PF_NEAR;
+  if (z < ClipFrustum.far)
+    f |= PF_FAR;
+
+  return f;
+}
+
+static short FindEdge(Mesh3D *mesh, IndexListT *faceEdge,
+                      u_short p0, u_short p1)
+{
+  short *ei = faceEdge->indices;
+  short n = faceEdge->count;
+
+  if (p0 > p1)
+    swapr(p0, p1);
+
+  while (--n >= 0) {
+    short k = *ei++;
+    EdgeT *edge = &mesh->edge[k];
+
+    if (edge->p0 == p0 && edge->p1 == p1)
+      return k;
+  }
+
+  return -1;
+}
+
+/*
+ * Both faces that share an edge get the same intersection point, as it's
+ * always calculated from edge vertices in the same order. Hence there are no
+ * cracks between clipped faces and the division is done once. Part of an edge
+ * that was already clipped may still cross a plane that the whole edge does
+ * not, due to rounding errors. Such intersection is not cached.
+ */
+static void Intersect(Object3D *object, Point3D *o, Point3D *s, Point3D *e,
+                      short side, u_short plane)
+{
+  if (side >= 0) {
+    Point3D *cached = &object->edgeClip[side];
+
+    if (cached->pad == (short)plane) {
+      o->x = cached->x;
+      o->y = cached->y;
+      o->z = cached->z;
+      return;
+    }
+
+    {
+      EdgeT *edge = &object->mesh->edge[side];
+      char *vertexFlags = object->vertexFlags;
+      u_char f0 = vertexFlags[edge->p0 >> 3];
+      u_char f1 = vertexFlags[edge->p1 >> 3];
+
+      if ((f0 ^ f1) & plane) {
+        void *vertex = object->vertex;
+
+        ClipEdge3D(cached, vertex + edge->p0, vertex + edge->p1, plane);
+        cached->pad = plane;
+
+        o->x = cached->x;
+        o->y = cached->y;
+        o->z = cached->z;
+        return;
+      }
+    }
+  }
+
+  ClipEdge3D(o, s, e, plane);
+}
+
+static short ClipPlane(Object3D *object, ClipPolyT *in, ClipPolyT *out,
+                       short n, u_short plane)
+{
+  Point3D *S = in->point;
+  short *side = in->side;
+  u_char *code = in->code;
+  bool S_inside = !(*code++ & plane);
+  bool needClose = true;
+  short m = 0;
+
+  if (S_inside) {
+    needClose = false;
+    out->point[m] = *S;
+    out->side[m] = *side;
+    out->code[m] = in->code[0];
+    m++;
+  }
+
+  while (--n) {
+    Point3D *E = S + 1;
+    bool E_inside = !(*code & plane);
+
+    if (S_inside != E_inside) {
+      Point3D *I = &out->point[m];
+
+      Intersect(object, I, S, E, *side, plane);
+      out->side[m] = E_inside ? *side : -1;
+      out->code[m] = Outcode(I) & ~plane;
+      m++;
+    }
+
+    if (E_inside) {
+      out->point[m] = *E;
+      out->side[m] = side[1];
+      out->code[m] = *code;
+      m++;
+    }
+
+    S_inside = E_inside;
+    S++; side++; code++;
+  }
+
+  if (needClose && m) {
+    out->point[m] = out->point[0];
+    out->side[m] = out->side[0];
+    out->code[m] = out->code[0];
+    m++;
+  }
+
+  return m;
+}
+
+short ClipFace3D(Object3D *object, short index, Point3D **outp) {
+  Mesh3D *mesh = object->mesh;
+  IndexListT *face = mesh->face[index];
+  u_char *vertexFlags = (u_char *)object->vertexFlags;
+  short n = face->count;
+  u_char clipAny = 0, clipAll = -1;
+
+  /* Trivial accept and reject. */
+  {
+    short *vi = face->indices;
+    short i = n - 1;
+
+    do {
+      u_char f = vertexFlags[*vi++];
+      clipAny |= f;
+      clipAll &= f;
+    } while (--i != -1);
+
+    if (clipAll)
+      return 0;
+    if (!clipAny)
+      return CLIP_INSIDE;
+  }
+
+  Assert(n + 7 <= MAXPOLY);
+
+  {
+    ClipPolyT *in = &poly[0];
+    ClipPolyT *out = &poly[1];
+    Point3D *vertex = object->vertex;
+    short *vi = face->indices;
+    short i;
+
+    for (i = 0; i < n; i++) {
+      short k = vi[i];
+      short l = vi[(i + 1 < n) ? i + 1 : 0];
+
+      in->point[i] = vertex[k];
+      in->code[i] = vertexFlags[k];
+      in->side[i] = object->edgeClip ?
+        FindEdge(mesh, mesh->faceEdge[index], k << 3, l << 3) : -1;
+    }
+
+    in->point[n] = in->point[0];
+    in->side[n] = in->side[0];
+    in->code[n] = in->code[0];
+    n++;
+
+    {
+      const u_short *plane = ClipOrder;
+      short j = 5;
+
+      do {
+        if (clipAny & *plane) {
+          n = ClipPlane(object, in, out, n, *plane);
+          swapr(in, out);
+          if (n == 0)
+            break;
+        }
+        plane++;
+      } while (--j != -1);
+    }
+
+    *outp = in->point;
+  }
+
+  return n;
+}
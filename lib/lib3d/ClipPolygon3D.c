@@ -2,53 +2,20 @@
 
 static bool CheckInside(Point3D *p, u_short plane) {
   if (plane & PF_LEFT)
-    return (p->x > p->z);
+    return (p->x >= p->z);
   if (plane & PF_RIGHT)
-    return (p->x < -p->z);
+    return (p->x <= -p->z);
   if (plane & PF_TOP)
-    return (p->y > p->z);
+    return (p->y >= p->z);
   if (plane & PF_BOTTOM)
-    return (p->y < -p->z);
+    return (p->y <= -p->z);
   if (plane & PF_NEAR)
-    return (p->z < ClipFrustum.near);
+    return (p->z <= ClipFrustum.near);
   if (plane & PF_FAR)
-    return (p->z > ClipFrustum.far);
+    return (p->z >= ClipFrustum.far);
   return false;
 }
 
-static void ClipEdge(Point3D *o, Point3D *s, Point3D *e, u_short plane) {
-  short dx = e->x - s->x;
-  short dy = e->y - s->y;
-  short dz = e->z - s->z;
-
-#if 0
-  if (plane & PF_LEFT) {
-    short n = s->z - s->x;
-    short d = dx - dz;
-
-    o->x = e->x + div16(dx * n, d);
-    o->y = e->y + div16(dy * n, d);
-    o->z = e->z + div16(dz * n, d);
-  } else if (plane & PF_RIGHT) {
-  } else if (plane & PF_TOP) {
-  } else if (plane & PF_BOTTOM) {
-  }
-#endif
-  if (plane & PF_NEAR) {
-    short n = ClipFrustum.near - s->z;
-
-    o->x = s->x + div16(dx * n, dz);
-    o->y = s->y + div16(dy * n, dz);
-    o->z = ClipFrustum.near;
-  } else if (plane & PF_FAR) {
-    short n = ClipFrustum.far - s->z;
-
-    o->x = s->x + div16(dx * n, dz);
-    o->y = s->y + div16(dy * n, dz);
-    o->z = ClipFrustum.far;
-  }
-}
-
 static u_short ClipPolygon(Point3D *S, Point3D *O, u_short n, u_short plane) {
   Point3D *E = S + 1;
 
@@ -67,9 +34,9 @@ static u_short ClipPolygon(Point3D *S, Point3D *O, u_short n, u_short plane) {
     if (S_inside && E_inside) {
       O[m++] = *E;
     } else if (S_inside && !E_inside) {
-      ClipEdge(&O[m++], S, E, plane);
+      ClipEdge3D(&O[m++], S, E, plane);
     } else if (!S_inside && E_inside) {
-      ClipEdge(&O[m++], E, S, plane);
+      ClipEdge3D(&O[m++], E, S, plane);
       O[m++] = *E;
     }
 
@@ -77,44 +44,32 @@ static u_short ClipPolygon(Point3D *S, Point3D *O, u_short n, u_short plane) {
     S++; E++;
   }
 
-  if (needClose)
+  if (needClose && m)
     O[m++] = *O;
 
   return m;
 }
 
+/* Near and far planes go first, so no point behind the camera is left. */
+static const u_short ClipOrder[6] = {
+  PF_NEAR, PF_FAR, PF_LEFT, PF_RIGHT, PF_TOP, PF_BOTTOM
+};
+
 u_short ClipPolygon3D(Point3D *in, Point3D **outp, u_short n, u_short clipFlags)
 {
   Point3D *out = *outp;
+  const u_short *plane = ClipOrder;
+  short i = 5;
 
-  if (clipFlags) {
-#if 0
-    if (clipFlags & PF_LEFT) {
-      n = ClipPolygon(in, out, n, PF_LEFT);
-      swapr(in, out);
-    }
-    if (clipFlags & PF_TOP) {
-      n = ClipPolygon(in, out, n, PF_TOP);
-      swapr(in, out);
-    }
-    if (clipFlags & PF_RIGHT) {
-      n = ClipPolygon(in, out, n, PF_RIGHT);
-      swapr(in, out);
-    }
-    if (clipFlags & PF_BOTTOM) {
-      n = ClipPolygon(in, out, n, PF_BOTTOM);
+  do {
+    if (clipFlags & *plane) {
+      n = ClipPolygon(in, out, n, *plane);
       swapr(in, out);
+      if (n == 0)
+        break;
     }
-#endif
-    if (clipFlags & PF_NEAR) {
-      n = ClipPolygon(in, out, n, PF_NEAR);
-      swapr(in, out);
-    }
-    if (clipFlags & PF_FAR) {
-      n = ClipPolygon(in, out, n, PF_FAR);
-      swapr(in, out);
-    }
-  }
+    plane++;
+  } while (--i != -1);
 
   *outp = in;
   return n;
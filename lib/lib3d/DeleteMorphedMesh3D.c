@@ -0,0 +1,10 @@
+#include <memory.h>
+#include <3d.h>
+
+void DeleteMorphedMesh3D(Mesh3D *mesh) {
+  if (mesh) {
+    MemFree(mesh->faceNormal);
+    MemFree(mesh->vertex);
+    MemFree(mesh);
+  }
+}
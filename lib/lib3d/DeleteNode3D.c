@@ -0,0 +1,17 @@
+#include <memory.h>
+#include <3d.h>
+
+/* Deletes the node with all its descendants, but not objects they refer to. */
+void DeleteNode3D(Node3D *node) {
+  if (node) {
+    Node3D *child = node->child;
+
+    while (child) {
+      Node3D *next = child->next;
+      DeleteNode3D(child);
+      child = next;
+    }
+
+    MemFree(node);
+  }
+}
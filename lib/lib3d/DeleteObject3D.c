@@ -3,7 +3,10 @@
 
 void DeleteObject3D(Object3D *object) {
   if (object) {
+    MemFree(object->faceDepth);
+    MemFree(object->sortBuffer);
     MemFree(object->visibleFace);
+    MemFree(object->edgeClip);
     MemFree(object->edgeFlags);
     MemFree(object->faceFlags);
     MemFree(object->vertexFlags);
@@ -0,0 +1,11 @@
+#include <memory.h>
+#include <3d.h>
+
+void DeleteScene3D(Scene3D *scene) {
+  if (scene) {
+    MemFree(scene->sortBuffer);
+    MemFree(scene->visibleFace);
+    MemFree(scene->object);
+    MemFree(scene);
+  }
+}
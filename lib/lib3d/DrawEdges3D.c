@@ -0,0 +1,100 @@
+#include <blitter.h>
+#include <3d.h>
+
+/*
+ * Edges are drawn with one dot per raster line in exclusive-or mode, so that
+ * bitplanes can be area filled afterwards. First dot of a line is written to
+ * scratchpad area of the bitmap.
+ */
+void DrawEdges3D(Object3D *object, const BitmapT *bitmap) {
+  short *edge = (short *)object->mesh->edge;
+  char *edgeFlags = object->edgeFlags;
+  void *point = object->vertex;
+  void *const *planes = bitmap->planes;
+  void *scratch = planes[bitmap->depth];
+  short stride = BitmapStride(bitmap);
+  short n = object->mesh->edges;
+
+  WaitBlitter();
+  custom->bltafwm = -1;
+  custom->bltalwm = -1;
+  custom->bltadat = 0x8000;
+  custom->bltbdat = 0xffff; /* Line texture pattern. */
+  custom->bltcmod = stride;
+  custom->bltdmod = stride;
+
+  while (--n >= 0) {
+    u_char f = *edgeFlags++;
+    short x0, y0, x1, y1;
+
+    if (!f) {
+      edge += 2;
+      continue;
+    }
+
+    {
+      short *p0 = point + *edge++;
+      short *p1 = point + *edge++;
+      x0 = *p0++; y0 = *p0++;
+      x1 = *p1++; y1 = *p1++;
+    }
+
+    if (y0 > y1) {
+      swapr(x0, x1);
+      swapr(y0, y1);
+    }
+
+    {
+      short dmax = x1 - x0;
+      short dmin = y1 - y0;
+      short derr;
+      u_short bltcon1 = LINEMODE | ONEDOT;
+
+      if (dmax < 0)
+        dmax = -dmax;
+
+      if (dmax >= dmin) {
+        if (x0 >= x1)
+          bltcon1 |= (AUL | SUD);
+        else
+          bltcon1 |= SUD;
+      } else {
+        if (x0 >= x1)
+          bltcon1 |= SUL;
+        swapr(dmax, dmin);
+      }
+
+      dmin <<= 1;
+      derr = dmin - dmax;
+      if (derr < 0)
+        bltcon1 |= SIGNFLAG;
+
+      {
+        short start = (y0 * stride + (x0 >> 3)) & ~1;
+        u_short bltcon0 = rorw(x0 & 15, 4) | BC0F_LINE_EOR;
+        u_short bltamod = derr - dmax;
+        u_short bltbmod = dmin;
+        u_short bltsize = (dmax << 6) + 66;
+        void *bltapt = (void *)(int)derr;
+        void *const *plane = planes;
+
+        /* Draw the edge into every bitplane that needs it. */
+        do {
+          if (f & 1) {
+            WaitBlitter();
+            custom->bltcon0 = bltcon0;
+            custom->bltcon1 = bltcon1;
+            custom->bltcpt = *plane + start;
+            custom->bltapt = bltapt;
+            custom->bltdpt = scratch;
+            custom->bltbmod = bltbmod;
+            custom->bltamod = bltamod;
+            custom->bltsize = bltsize;
+          }
+          plane++;
+          f >>= 1;
+        } while (f);
+      }
+    }
+  }
+}
@@ -0,0 +1,22 @@
+#include <string.h>
+#include <memory.h>
+#include <3d.h>
+
+Mesh3D *NewMorphedMesh3D(Mesh3D *base) {
+  Mesh3D *mesh = MemAlloc(sizeof(Mesh3D), MEMF_PUBLIC);
+  short vertices = base->vertices;
+  short faces = base->faces;
+
+  /* Face normals are not precomputed unless lwo2c was run with --topology. */
+  CalculateFaceNormals(base);
+
+  memcpy(mesh, base, sizeof(Mesh3D));
+  mesh->vertex = MemAlloc(sizeof(Point3D) * vertices, MEMF_PUBLIC);
+  mesh->faceNormal = MemAlloc(sizeof(Point3D) * faces, MEMF_PUBLIC);
+  mesh->allocated = 0;
+
+  memcpy(mesh->vertex, base->vertex, sizeof(Point3D) * vertices);
+  memcpy(mesh->faceNormal, base->faceNormal, sizeof(Point3D) * faces);
+
+  return mesh;
+}
@@ -0,0 +1,15 @@
+#include <memory.h>
+#include <3d.h>
+#include <fx.h>
+
+Node3D *NewNode3D(Object3D *object) {
+  Node3D *node = MemAlloc(sizeof(Node3D), MEMF_PUBLIC|MEMF_CLEAR);
+
+  node->object = object;
+  node->scale.x = fx12f(1.0);
+  node->scale.y = fx12f(1.0);
+  node->scale.z = fx12f(1.0);
+  node->flags = NODE_DIRTY;
+
+  return node;
+}
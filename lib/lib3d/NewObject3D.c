@@ -12,9 +12,14 @@ Object3D *NewObject3D(Mesh3D *mesh) {
   object->vertex = MemAlloc(sizeof(Point3D) * vertices, MEMF_PUBLIC);
   object->vertexFlags = MemAlloc(vertices, MEMF_PUBLIC);
   object->faceFlags = MemAlloc(faces, MEMF_PUBLIC);
-  if (edges)
+  if (edges) {
     object->edgeFlags = MemAlloc(edges, MEMF_PUBLIC);
+    object->edgeClip =
+      MemAlloc(sizeof(Point3D) * edges, MEMF_PUBLIC|MEMF_CLEAR);
+  }
   object->visibleFace = MemAlloc(sizeof(SortItemT) * faces, MEMF_PUBLIC);
+  object->sortBuffer = MemAlloc(sizeof(SortItemT) * faces, MEMF_PUBLIC);
+  object->faceDepth = MemAlloc(sizeof(short) * faces, MEMF_PUBLIC);
 
   object->scale.x = fx12f(1.0);
   object->scale.y = fx12f(1.0);
@@ -0,0 +1,36 @@
+#include <debug.h>
+#include <memory.h>
+#include <3d.h>
+
+static void CountObjects(Node3D *node, short *objects, short *faces) {
+  for (; node; node = node->next) {
+    Object3D *object = node->object;
+
+    if (object) {
+      short n = object->mesh->faces;
+      Assert(n <= SCENE_FACE_MASK + 1);
+      (*objects)++;
+      *faces += n;
+    }
+
+    CountObjects(node->child, objects, faces);
+  }
+}
+
+Scene3D *NewScene3D(Node3D *root) {
+  Scene3D *scene = MemAlloc(sizeof(Scene3D), MEMF_PUBLIC|MEMF_CLEAR);
+  short objects = 0;
+  short faces = 0;
+
+  CountObjects(root, &objects, &faces);
+  Assert(objects <= (1 << (16 - SCENE_FACE_BITS)));
+
+  scene->root = root;
+  scene->camera.flags = NODE_DIRTY;
+  scene->objects = objects;
+  scene->object = MemAlloc(sizeof(Object3D *) * objects, MEMF_PUBLIC);
+  scene->visibleFace = MemAlloc(sizeof(SortItemT) * faces, MEMF_PUBLIC);
+  scene->sortBuffer = MemAlloc(sizeof(SortItemT) * faces, MEMF_PUBLIC);
+
+  return scene;
+}
@@ -0,0 +1,132 @@
+#include <3d.h>
+
+/*
+ * Order of visible faces changes very little between consecutive frames, so
+ * instead of sorting from scratch the order from previous frame is repaired:
+ *
+ * 1. Faces that are still visible are updated in previous order, the rest is
+ *    dropped. An insertion pass restores the order. It takes time linear
+ *    in number of order changes.
+ * 2. Newly visible faces are sorted separately and merged in.
+ *
+ * If the order changed a lot (e.g. on a scene cut) full sort is performed.
+ * Number of items moved is stored in sortWork, so it can be profiled.
+ *
+ * Depth keys are taken from faceDepth, where invisible faces are marked with
+ * NOFACE. This array is trashed in the process.
+ */
+
+/* Returns number of faces that remained visible. */
+static short UpdateOrder(Object3D *object) {
+  short *depth = object->faceDepth;
+  SortItemT *src = object->visibleFace;
+  SortItemT *dst = src;
+  short n = object->visibleFaces;
+
+  while (--n >= 0) {
+    short index = (src++)->index;
+    short z = depth[index];
+
+    if (z != NOFACE) {
+      dst->key = z;
+      dst->index = index;
+      dst++;
+      /* Mark face as already placed. */
+      depth[index] = NOFACE;
+    }
+  }
+
+  return dst - object->visibleFace;
+}
+
+/* Returns number of moves, or -1 if it took too long. */
+static int InsertionPass(SortItemT *table, short size, int limit) {
+  SortItemT *first = table;
+  SortItemT *ptr = table + 1;
+  int moves = 0;
+
+  while (--size > 0) {
+    SortItemT *curr = ptr;
+    SortItemT *prev = ptr - 1;
+    SortItemT this = *ptr++;
+
+    if (prev->key <= this.key)
+      continue;
+
+    do {
+      *curr-- = *prev--;
+      moves++;
+    } while (prev >= first && prev->key > this.key);
+
+    *curr = this;
+
+    if (moves > limit)
+      return -1;
+  }
+
+  return moves;
+}
+
+/* Collect faces that weren't visible in previous frame. */
+static short NewFaces(Object3D *object) {
+  short *depth = object->faceDepth;
+  SortItemT *item = object->sortBuffer;
+  short n = object->mesh->faces;
+  short index = 0;
+
+  while (--n >= 0) {
+    short z = *depth++;
+
+    if (z != NOFACE) {
+      item->key = z;
+      item->index = index;
+      item++;
+    }
+
+    index++;
+  }
+
+  return item - object->sortBuffer;
+}
+
+/* Merges from the back, so that no extra space is needed. */
+static int Merge(SortItemT *table, short size, SortItemT *add, short count) {
+  SortItemT *old = table + size - 1;
+  SortItemT *new = add + count - 1;
+  SortItemT *dst = table + size + count - 1;
+  int moves = count;
+
+  while (new >= add) {
+    if (old >= table && old->key > new->key) {
+      *dst-- = *old--;
+      moves++;
+    } else {
+      *dst-- = *new--;
+    }
+  }
+
+  return moves;
+}
+
+void OrderFaces(Object3D *object) {
+  SortItemT *visibleFace = object->visibleFace;
+  short count, added;
+  int moves;
+
+  count = UpdateOrder(object);
+  moves = InsertionPass(visibleFace, count, count * 4);
+  if (moves < 0) {
+    RadixSortItemArray(visibleFace, object->sortBuffer, count);
+    moves = count;
+  }
+
+  added = NewFaces(object);
+  if (added > 0) {
+    /* Free space after items in visibleFace is large enough. */
+    RadixSortItemArray(object->sortBuffer, visibleFace + count, added);
+    moves += Merge(visibleFace, count, object->sortBuffer, added);
+  }
+
+  object->visibleFaces = count + added;
+  object->sortWork = min(moves, 65535);
+}
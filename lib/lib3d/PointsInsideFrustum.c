@@ -1,7 +1,8 @@
 #include <3d.h>
 
-void PointsInsideFrustum(Point3D *in, u_char *flags, u_short n) {
+u_char PointsInsideFrustum(Point3D *in, u_char *flags, u_short n) {
   short *src = (short *)in;
+  u_char clip = 0;
 
   while (n--) {
     short x = *src++;
@@ -9,6 +10,8 @@ void PointsInsideFrustum(Point3D *in, u_char *flags, u_short n) {
     short z = *src++;
     u_char f = 0;
 
+    src++; /* skip pad */
+
     if (x < z)
       f |= PF_LEFT;
     if (x > -z)
@@ -23,5 +26,8 @@ void PointsInsideFrustum(Point3D *in, u_char *flags, u_short n) {
       f |= PF_FAR;
 
     *flags++ = f;
+    clip |= f;
   }
+
+  return clip;
 }
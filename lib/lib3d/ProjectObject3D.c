@@ -0,0 +1,157 @@
+#include <strings.h>
+#include <3d.h>
+#include <fx.h>
+
+/*
+ * Rows of object to world transformation matrix with translation scaled up,
+ * so that it can be added before the product is normalized.
+ *
+ * On m68k each row is evaluated as:
+ *
+ *   (m0 + y) * (m1 + x) + m2 * z - x * y + (t - m0 * m1)
+ *
+ * It takes two multiplications instead of three, since x * y is shared by
+ * all rows. Sums of matrix coefficients and coordinates must fit in a word.
+ */
+typedef struct {
+  short m0, m1, m2;
+  short pad;
+  int t;
+} RowT;
+
+static void LoadRows(RowT *row, Matrix3D *M) {
+  short *m = (short *)M;
+  short n = 2;
+
+  do {
+    row->m0 = *m++;
+    row->m1 = *m++;
+    row->m2 = *m++;
+    row->t = *m++ << 12;
+#ifdef __mc68000__
+    row->t -= row->m0 * row->m1;
+#endif
+    row++;
+  } while (--n != -1);
+}
+
+#ifdef __mc68000__
+static inline int MulRow(RowT *row, short x, short y, short z, int xy) {
+  int r, t;
+  asm("movew %2@,%0\n"
+      "addw  %4,%0\n"
+      "movew %2@(2),%1\n"
+      "addw  %3,%1\n"
+      "mulsw %1,%0\n"
+      "movew %2@(4),%1\n"
+      "mulsw %5,%1\n"
+      "addl  %1,%0\n"
+      "subl  %6,%0\n"
+      "addl  %2@(8),%0\n"
+      : "=&d" (r), "=&d" (t)
+      : "a" (row), "d" (x), "d" (y), "d" (z), "d" (xy), "m" (*row));
+  return r;
+}
+#else
+/* Reference implementation, gives the same results as the one above. */
+static inline int MulRow(RowT *row, short x, short y, short z, int xy) {
+  (void)xy;
+  return row->m0 * x + row->m1 * y + row->m2 * z + row->t;
+}
+#endif
+
+static inline void ProjectVertex(RowT *row, short *src, short *dst,
+                                 short cx, short cy)
+{
+  short x = *src++;
+  short y = *src++;
+  short z = *src++;
+  int xy = x * y;
+  int xp = MulRow(&row[0], x, y, z, xy) >> 4;
+  int yp = MulRow(&row[1], x, y, z, xy) >> 4;
+  short zp = normfx(MulRow(&row[2], x, y, z, xy));
+
+  *dst++ = div16(xp, zp) + cx; /* div(xp * 256, zp) */
+  *dst++ = div16(yp, zp) + cy; /* div(yp * 256, zp) */
+  *dst++ = zp;
+}
+
+void ProjectObject3D(Object3D *object, short cx, short cy) {
+  Mesh3D *mesh = object->mesh;
+  short *normal = (short *)mesh->faceNormal;
+  IndexListT **faces = mesh->face;
+  void *vertex = mesh->vertex;
+  void *point = object->vertex;
+  char *vertexFlags = object->vertexFlags;
+  char *faceFlags = object->faceFlags;
+  short *depth = object->faceDepth;
+  short *camera = (short *)&object->camera;
+  short n = mesh->faces;
+  RowT row[3];
+
+  LoadRows(row, &object->objectToWorld);
+  bzero(vertexFlags, mesh->vertices);
+
+  while (--n >= 0) {
+    IndexListT *face = *faces++;
+    short *vi = face->indices;
+    short px, py, pz;
+    int f;
+
+    /* Cull faces that point away from the camera. */
+    {
+      short *p = (short *)(vertex + (short)(*vi << 3));
+      px = camera[0] - *p++;
+      py = camera[1] - *p++;
+      pz = camera[2] - *p++;
+    }
+
+    f = normal[0] * px + normal[1] * py + normal[2] * pz;
+    normal += 4;
+
+    if (f < 0) {
+      *faceFlags++ = -1;
+      *depth++ = NOFACE;
+      continue;
+    }
+
+    /* Normalize dot product to get intensity. */
+    {
+      short s = swap16(px * px + py * py + pz * pz);
+      short l;
+
+      f = swap16(f);
+      l = div16((short)f * (short)f, s);
+      *faceFlags++ = (l >= 256) ? 15 : SqrtTab8[l];
+    }
+
+    /* Project vertices that have not been visited yet. */
+    {
+      short m = face->count - 1;
+
+      do {
+        short k = *vi++;
+
+        if (!vertexFlags[k]) {
+          short o = k << 3;
+          vertexFlags[k] = -1;
+          ProjectVertex(row, vertex + o, point + o, cx, cy);
+        }
+      } while (--m != -1);
+    }
+
+    /* Depth key is calculated the same way as in SortFaces. */
+    {
+      short i1 = face->indices[0] << 3;
+      short i2 = face->indices[1] << 3;
+      short i3 = face->indices[2] << 3;
+      short z;
+
+      z = *(short *)(point + i1 + 4);
+      z += *(short *)(point + i2 + 4);
+      z += *(short *)(point + i3 + 4);
+
+      *depth++ = z;
+    }
+  }
+}
@@ -1,17 +1,32 @@
 #include <3d.h>
 #include <memory.h>
 
+/* Releases structures allocated by Calculate* functions. */
 void ResetMesh3D(Mesh3D *mesh) {
-  MemFree(mesh->faceNormal);
-  MemFree(mesh->vertexNormal);
-  MemFree(mesh->edge);
-  MemFree(mesh->faceEdge);
-  MemFree(mesh->vertexFace);
+  u_short allocated = mesh->allocated;
 
-  mesh->edges = 0;
-  mesh->faceNormal = NULL;
-  mesh->vertexNormal = NULL;
-  mesh->edge = NULL;
-  mesh->faceEdge = NULL;
-  mesh->vertexFace = NULL;
+  if (allocated & MESH_FACE_NORMAL) {
+    MemFree(mesh->faceNormal);
+    mesh->faceNormal = NULL;
+  }
+
+  if (allocated & MESH_VERTEX_NORMAL) {
+    MemFree(mesh->vertexNormal);
+    mesh->vertexNormal = NULL;
+  }
+
+  if (allocated & MESH_EDGES) {
+    MemFree(mesh->edge);
+    MemFree(mesh->faceEdge);
+    mesh->edges = 0;
+    mesh->edge = NULL;
+    mesh->faceEdge = NULL;
+  }
+
+  if (allocated & MESH_VERTEX_FACE) {
+    MemFree(mesh->vertexFace);
+    mesh->vertexFace = NULL;
+  }
+
+  mesh->allocated = 0;
 }
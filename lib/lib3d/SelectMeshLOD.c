@@ -0,0 +1,18 @@
+#include <3d.h>
+
+/*
+ * Returns index of the simplest level whose error, when projected onto
+ * screen at depth z, stays within maxError pixels. Perspective projection
+ * of ProjectObject3D is assumed, i.e. x' = x * 256 / z.
+ */
+short SelectMeshLOD(MeshLOD3D *lod, short z, short maxError) {
+  short i = lod->levels - 1;
+  MeshLevelT *level = &lod->level[i];
+  int limit = maxError * absw(z);
+
+  for (; i > 0; i--, level--)
+    if (((int)level->error << 8) <= limit)
+      break;
+
+  return i;
+}
@@ -1,38 +1,30 @@
 #include <3d.h>
 
+/* Calculates depth keys of visible faces and puts them in order. */
 void SortFaces(Object3D *object) {
   IndexListT **faces = object->mesh->face;
   short n = object->mesh->faces;
   void *point = object->vertex;
   char *faceFlags = object->faceFlags;
-  short count = 0;
-  short index = 0;
-
-  short *item = (short *)object->visibleFace;
+  short *depth = object->faceDepth;
 
   while (--n >= 0) {
     IndexListT *face = *faces++;
+    short z = NOFACE;
 
     if (*faceFlags++ >= 0) {
       short *vi = face->indices;
       short i1 = *vi++ << 3;
       short i2 = *vi++ << 3;
       short i3 = *vi++ << 3;
-      short z = 0;
 
-      z += *(short *)(point + i1 + 4);
+      z = *(short *)(point + i1 + 4);
       z += *(short *)(point + i2 + 4);
       z += *(short *)(point + i3 + 4);
-
-      *item++ = z;
-      *item++ = index;
-      count++;
     }
 
-    index++;
+    *depth++ = z;
   }
 
-  object->visibleFaces = count;
-
-  SortItemArray(object->visibleFace, count);
+  OrderFaces(object);
 }
@@ -0,0 +1,23 @@
+#include <3d.h>
+
+/*
+ * Cached intersections of edges with clipping planes are no longer valid as
+ * vertices have moved.
+ */
+u_char UpdateClipFlags(Object3D *object) {
+  u_char clip = PointsInsideFrustum(object->vertex,
+                                    (u_char *)object->vertexFlags,
+                                    object->mesh->vertices);
+
+  if (clip && object->edgeClip) {
+    Point3D *edge = object->edgeClip;
+    short n = object->mesh->edges;
+
+    while (--n >= 0) {
+      edge->pad = 0;
+      edge++;
+    }
+  }
+
+  return clip;
+}
@@ -0,0 +1,45 @@
+#include <strings.h>
+#include <3d.h>
+
+/*
+ * Color of each visible face is xor'ed into flags of its edges. An edge
+ * shared by two faces is drawn only into bitplanes where colors of the faces
+ * differ, so after area fill each face gets its own color. Faces must not
+ * overlap on screen, which holds for closed convex meshes.
+ */
+void UpdateEdgeVisibility(Object3D *object) {
+  char *vertexFlags = object->vertexFlags;
+  char *edgeFlags = object->edgeFlags;
+  char *faceFlags = object->faceFlags;
+  IndexListT **faces = object->mesh->face;
+  IndexListT *face = *faces++;
+  IndexListT **faceEdges = object->mesh->faceEdge;
+  IndexListT *faceEdge = *faceEdges++;
+
+  bzero(vertexFlags, object->mesh->vertices);
+  bzero(edgeFlags, object->mesh->edges);
+
+  do {
+    char f = *faceFlags++;
+
+    if (f >= 0) {
+      short n = face->count - 3;
+      short *vi = face->indices;
+      short *ei = faceEdge->indices;
+
+      /* Face has at least (and usually) three vertices / edges. */
+      vertexFlags[*vi++] = -1;
+      edgeFlags[*ei++] ^= f;
+      vertexFlags[*vi++] = -1;
+      edgeFlags[*ei++] ^= f;
+
+      do {
+        vertexFlags[*vi++] = -1;
+        edgeFlags[*ei++] ^= f;
+      } while (--n != -1);
+    }
+
+    faceEdge = *faceEdges++;
+    face = *faces++;
+  } while (face);
+}
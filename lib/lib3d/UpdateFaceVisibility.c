@@ -35,7 +35,7 @@ void UpdateFaceVisibility(Object3D *object) {
     if (f >= 0) {
       /* normalize dot product */
       short l;
-#if 0
+#ifndef __mc68000__
       int s = px * px + py * py + pz * pz;
       s = swap16(s); /* s >>= 16, ignore upper word */
 #else
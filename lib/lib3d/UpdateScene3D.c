@@ -0,0 +1,173 @@
+#include <debug.h>
+#include <3d.h>
+#include <fx.h>
+
+/*
+ * Matrices of a node are recalculated only if the node was marked with
+ * NODE_DIRTY or any of its ancestors has moved. Vertices of an object are
+ * projected again only if the object or the camera has moved, otherwise
+ * results from previous frame are still valid.
+ */
+
+/* Compose3D multiplies rotations but it only adds up translations. */
+static void Multiply(Matrix3D *d, Matrix3D *a, Matrix3D *b) {
+  Compose3D(d, a, b);
+  d->x = normfx(a->m00 * b->x + a->m01 * b->y + a->m02 * b->z) + a->x;
+  d->y = normfx(a->m10 * b->x + a->m11 * b->y + a->m12 * b->z) + a->y;
+  d->z = normfx(a->m20 * b->x + a->m21 * b->y + a->m22 * b->z) + a->z;
+}
+
+static void ScaleRows(Matrix3D *M, short sx, short sy, short sz) {
+  short *m = &M->m00;
+  short n = 2;
+
+  do {
+    *m = normfx(*m * sx); m++;
+    *m = normfx(*m * sx); m++;
+    *m = normfx(*m * sx); m++;
+    m++;
+    sx = sy; sy = sz;
+  } while (--n != -1);
+}
+
+/* Inverse of 4.12 scale factor, which must fit in a word as well. */
+static short InvScale(short s) {
+  Assert(s > 0x200 || s < -0x200);
+  return div16(1 << 24, s);
+}
+
+/* Mirrors UpdateObjectTransformation. */
+static void UpdateLocal(Node3D *node) {
+  Point3D *rotate = &node->rotate;
+  Point3D *scale = &node->scale;
+  Point3D *translate = &node->translate;
+
+  /* node -> parent: Rx * Ry * Rz * S * T */
+  {
+    Matrix3D *m = &node->local;
+    LoadRotate3D(m, rotate->x, rotate->y, rotate->z);
+    Scale3D(m, scale->x, scale->y, scale->z);
+    Translate3D(m, translate->x, translate->y, translate->z);
+  }
+
+  /* parent -> node without translation: S^-1 * Rz^-1 * Ry^-1 * Rx^-1 */
+  {
+    Matrix3D *m = &node->localInv;
+    LoadReverseRotate3D(m, -rotate->x, -rotate->y, -rotate->z);
+    ScaleRows(m, InvScale(scale->x), InvScale(scale->y), InvScale(scale->z));
+  }
+}
+
+static void UpdateCamera(Camera3D *camera) {
+  Point3D *rotate = &camera->rotate;
+  Point3D *translate = &camera->translate;
+  Matrix3D *m = &camera->worldToCamera;
+
+  /* world -> camera: T^-1 * Rz^-1 * Ry^-1 * Rx^-1 */
+  LoadReverseRotate3D(m, -rotate->x, -rotate->y, -rotate->z);
+
+  m->x = -normfx(m->m00 * translate->x + m->m01 * translate->y +
+                 m->m02 * translate->z);
+  m->y = -normfx(m->m10 * translate->x + m->m11 * translate->y +
+                 m->m12 * translate->z);
+  m->z = -normfx(m->m20 * translate->x + m->m21 * translate->y +
+                 m->m22 * translate->z);
+}
+
+static void UpdateObject(Node3D *node, Camera3D *camera) {
+  Object3D *object = node->object;
+  Matrix3D *M = &node->worldInv;
+  short cx = camera->translate.x - node->world.x;
+  short cy = camera->translate.y - node->world.y;
+  short cz = camera->translate.z - node->world.z;
+
+  /* Projection pipeline expects object -> camera transformation. */
+  Multiply(&object->objectToWorld, &camera->worldToCamera, &node->world);
+
+  /* calculate camera position in object space */
+  object->camera.x = normfx(M->m00 * cx + M->m01 * cy + M->m02 * cz);
+  object->camera.y = normfx(M->m10 * cx + M->m11 * cy + M->m12 * cz);
+  object->camera.z = normfx(M->m20 * cx + M->m21 * cy + M->m22 * cz);
+
+  ProjectObject3D(object, camera->cx, camera->cy);
+}
+
+static short UpdateNodes(Scene3D *scene, Node3D *node, short objects,
+                         bool parentMoved, bool cameraMoved)
+{
+  for (; node; node = node->next) {
+    Node3D *parent = node->parent;
+    bool moved = (parentMoved || (node->flags & NODE_DIRTY)) ? true : false;
+
+    if (node->flags & NODE_DIRTY)
+      UpdateLocal(node);
+
+    if (moved) {
+      if (parent) {
+        Multiply(&node->world, &parent->world, &node->local);
+        Compose3D(&node->worldInv, &node->localInv, &parent->worldInv);
+      } else {
+        node->world = node->local;
+        node->worldInv = node->localInv;
+      }
+    }
+
+    node->flags = moved ? NODE_MOVED : 0;
+
+    if (node->object) {
+      if (moved || cameraMoved)
+        UpdateObject(node, &scene->camera);
+      scene->object[objects++] = node->object;
+    }
+
+    objects = UpdateNodes(scene, node->child, objects, moved, cameraMoved);
+  }
+
+  return objects;
+}
+
+static void CollectFaces(Scene3D *scene) {
+  SortItemT *item = scene->visibleFace;
+  Object3D **objects = scene->object;
+  short n = scene->objects;
+  short base = 0;
+
+  while (--n >= 0) {
+    Object3D *object = *objects++;
+    short *depth = object->faceDepth;
+    short m = object->mesh->faces;
+    short index = base;
+
+    while (--m >= 0) {
+      short z = *depth++;
+
+      if (z != NOFACE) {
+        item->key = z;
+        item->index = index;
+        item++;
+      }
+
+      index++;
+    }
+
+    base += 1 << SCENE_FACE_BITS;
+  }
+
+  scene->visibleFaces = item - scene->visibleFace;
+}
+
+void UpdateScene3D(Scene3D *scene) {
+  Camera3D *camera = &scene->camera;
+  bool cameraMoved = (camera->flags & NODE_DIRTY) ? true : false;
+
+  if (cameraMoved)
+    UpdateCamera(camera);
+
+  camera->flags = 0;
+
+  (void)UpdateNodes(scene, scene->root, 0, false, cameraMoved);
+
+  CollectFaces(scene);
+  RadixSortItemArray(scene->visibleFace, scene->sortBuffer,
+                     scene->visibleFaces);
+}
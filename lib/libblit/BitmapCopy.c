@@ -3,6 +3,17 @@
 void BitmapCopy(const BitmapT *dst, u_short x, u_short y, const BitmapT *src) {
   short i, n = min(dst->depth, src->depth);
 
+  if (BitmapsInterleaved(dst, src) &&
+      src->height * src->depth <= BLIT_MAXROWS) {
+    BitmapT flatDst, flatSrc;
+
+    InitFlatBitmap(&flatDst, dst);
+    InitFlatBitmap(&flatSrc, src);
+    BlitterCopySetup(&flatDst, x, y * dst->depth, &flatSrc);
+    BlitterCopyStart(0, 0);
+    return;
+  }
+
   BlitterCopySetup(dst, x, y, src);
   for (i = 0; i < n; i++)
     BlitterCopyStart(i, i);
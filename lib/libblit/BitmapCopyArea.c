@@ -5,6 +5,19 @@ void BitmapCopyArea(const BitmapT *dst, u_short x, u_short y,
 {
   short i, n = min(dst->depth, src->depth);
 
+  if (BitmapsInterleaved(dst, src) &&
+      area->h * src->depth <= BLIT_MAXROWS) {
+    BitmapT flatDst, flatSrc;
+    Area2D flatArea = { area->x, area->y * src->depth,
+                        area->w, area->h * src->depth };
+
+    InitFlatBitmap(&flatDst, dst);
+    InitFlatBitmap(&flatSrc, src);
+    BlitterCopyAreaSetup(&flatDst, x, y * dst->depth, &flatSrc, &flatArea);
+    BlitterCopyAreaStart(0, 0);
+    return;
+  }
+
   BlitterCopyAreaSetup(dst, x, y, src, area);
   for (i = 0; i < n; i++)
     BlitterCopyAreaStart(i, i);
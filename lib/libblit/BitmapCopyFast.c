@@ -5,6 +5,17 @@ void BitmapCopyFast(const BitmapT *dst, u_short x, u_short y,
 {
   short i, n = min(dst->depth, src->depth);
 
+  if (BitmapsInterleaved(dst, src) &&
+      src->height * src->depth <= BLIT_MAXROWS) {
+    BitmapT flatDst, flatSrc;
+
+    InitFlatBitmap(&flatDst, dst);
+    InitFlatBitmap(&flatSrc, src);
+    BlitterCopyFastSetup(&flatDst, x, y * dst->depth, &flatSrc);
+    BlitterCopyFastStart(0, 0);
+    return;
+  }
+
   BlitterCopyFastSetup(dst, x, y, src);
   for (i = 0; i < n; i++)
     BlitterCopyFastStart(i, i);
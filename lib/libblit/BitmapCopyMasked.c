@@ -5,6 +5,19 @@ void BitmapCopyMasked(const BitmapT *dst, u_short x, u_short y,
 {
   short i, n = min(dst->depth, src->depth);
 
+  /* Interleaved mask is made by BitmapMakeMask for interleaved bitmap. */
+  if (BitmapsInterleaved(dst, src) && BitmapsInterleaved(src, msk) &&
+      src->height * src->depth <= BLIT_MAXROWS) {
+    BitmapT flatDst, flatSrc, flatMsk;
+
+    InitFlatBitmap(&flatDst, dst);
+    InitFlatBitmap(&flatSrc, src);
+    InitFlatBitmap(&flatMsk, msk);
+    BlitterCopyMaskedSetup(&flatDst, x, y * dst->depth, &flatSrc, &flatMsk);
+    BlitterCopyMaskedStart(0, 0);
+    return;
+  }
+
   BlitterCopyMaskedSetup(dst, x, y, src, msk);
   for (i = 0; i < n; i++)
     BlitterCopyMaskedStart(i, i);
@@ -1,8 +1,19 @@
 #include <blitter.h>
 
+/*
+ * Mask of an interleaved bitmap is interleaved as well and has the same depth,
+ * with all bitplanes equal, so that cookie-cut blits can do all bitplanes at
+ * once.
+ */
 BitmapT *BitmapMakeMask(const BitmapT *bitmap) {
-  BitmapT *mask = NewBitmap(bitmap->width, bitmap->height, 1);
+  bool interleaved = (bitmap->flags & BM_INTERLEAVED) ? true : false;
+  BitmapT *mask = interleaved
+    ? NewBitmapCustom(bitmap->width, bitmap->height, bitmap->depth,
+                      BM_CLEAR | BM_DISPLAYABLE | BM_INTERLEAVED)
+    : NewBitmap(bitmap->width, bitmap->height, 1);
   u_short bltsize = (bitmap->height << 6) | (bitmap->bytesPerRow >> 1);
+  u_short srcmod = BitmapStride(bitmap) - bitmap->bytesPerRow;
+  u_short mskmod = BitmapStride(mask) - bitmap->bytesPerRow;
   void **planes = bitmap->planes;
   void *dst = mask->planes[0];
   short n = bitmap->depth;
@@ -12,9 +23,9 @@ BitmapT *BitmapMakeMask(const BitmapT *bitmap) {
 
     WaitBlitter();
 
-    custom->bltamod = 0;
-    custom->bltbmod = 0;
-    custom->bltdmod = 0;
+    custom->bltamod = srcmod;
+    custom->bltbmod = mskmod;
+    custom->bltdmod = mskmod;
     custom->bltcon0 = (SRCA | SRCB | DEST) | A_OR_B;
     custom->bltcon1 = 0;
     custom->bltafwm = -1;
@@ -26,5 +37,21 @@ BitmapT *BitmapMakeMask(const BitmapT *bitmap) {
     custom->bltsize = bltsize;
   }
 
+  if (interleaved) {
+    short i;
+
+    for (i = 1; i < mask->depth; i++) {
+      WaitBlitter();
+
+      custom->bltamod = mskmod;
+      custom->bltdmod = mskmod;
+      custom->bltcon0 = (SRCA | DEST) | A_TO_D;
+
+      custom->bltapt = dst;
+      custom->bltdpt = mask->planes[i];
+      custom->bltsize = bltsize;
+    }
+  }
+
   return mask;
 }
@@ -3,6 +3,26 @@
 void BitmapSetArea(const BitmapT *bitmap, const Area2D *area, u_short color) {
   short i;
 
+  /* Single blit works only if all bitplanes get the same pattern. */
+  if ((bitmap->flags & BM_INTERLEAVED) &&
+      (color == 0 || color == (1 << bitmap->depth) - 1) &&
+      (area ? area->h : bitmap->height) * bitmap->depth <= BLIT_MAXROWS)
+  {
+    BitmapT flat;
+    Area2D flatArea;
+
+    InitFlatBitmap(&flat, bitmap);
+    if (area) {
+      flatArea.x = area->x;
+      flatArea.y = area->y * bitmap->depth;
+      flatArea.w = area->w;
+      flatArea.h = area->h * bitmap->depth;
+    }
+    BlitterSetAreaSetup(&flat, area ? &flatArea : NULL);
+    BlitterSetAreaStart(0, color ? -1 : 0);
+    return;
+  }
+
   BlitterSetAreaSetup(bitmap, area);
   for (i = 0; i < bitmap->depth; i++) {
     BlitterSetAreaStart(i, (color & (1 << i)) ? -1 : 0);
@@ -0,0 +1,134 @@
+#include <blitter.h>
+#include <interrupt.h>
+
+#define BLITQ_MASK (BLITQ_SIZE - 1)
+
+typedef struct BlitEntry {
+  BlitCmdT cmd;
+  BlitNotifyT notify;
+  void *data;
+} BlitEntryT;
+
+/*
+ * Blits from 'head' to 'tail' are waiting to be started. Both are ever
+ * growing counters, so 'tail' is also the fence of most recently queued blit
+ * and blits up to 'done' have finished.
+ */
+static struct {
+  BlitEntryT entry[BLITQ_SIZE];
+  volatile u_short head;
+  volatile u_short tail;
+  volatile u_short done;
+  volatile bool busy;
+} bq;
+
+static void BlitterIssue(const BlitCmdT *cmd) {
+  custom->bltcon0 = cmd->bltcon0;
+  custom->bltcon1 = cmd->bltcon1;
+  custom->bltafwm = cmd->bltafwm;
+  custom->bltalwm = cmd->bltalwm;
+  custom->bltcpt = cmd->bltcpt;
+  custom->bltbpt = cmd->bltbpt;
+  custom->bltapt = cmd->bltapt;
+  custom->bltdpt = cmd->bltdpt;
+  custom->bltcmod = cmd->bltcmod;
+  custom->bltbmod = cmd->bltbmod;
+  custom->bltamod = cmd->bltamod;
+  custom->bltdmod = cmd->bltdmod;
+  custom->bltcdat = cmd->bltcdat;
+  custom->bltbdat = cmd->bltbdat;
+  custom->bltadat = cmd->bltadat;
+  custom->bltsize = cmd->bltsize;
+}
+
+static void BlitQueueHandler(void) {
+  BlitEntryT *entry;
+  BlitNotifyT notify;
+  void *data;
+
+  ClearIRQ(INTF_BLIT);
+
+  /* Ignore interrupts of blits that were not queued. */
+  if (!bq.busy)
+    return;
+
+  /* Keep the blitter busy first, callback can wait. */
+  entry = &bq.entry[bq.done & BLITQ_MASK];
+
+  if (bq.head != bq.tail) {
+    BlitterIssue(&bq.entry[bq.head & BLITQ_MASK].cmd);
+    bq.head++;
+  } else {
+    bq.busy = false;
+  }
+
+  /* The slot of finished blit gets reused as soon as 'done' moves. */
+  notify = entry->notify;
+  data = entry->data;
+  bq.done++;
+
+  if (notify)
+    notify(data);
+}
+
+void InitBlitQueue(void) {
+  bq.head = bq.tail = bq.done = 0;
+  bq.busy = false;
+
+  SetIntVector(BLIT, (IntHandlerT)BlitQueueHandler, NULL);
+  ClearIRQ(INTF_BLIT);
+  EnableINT(INTF_BLIT);
+}
+
+void KillBlitQueue(void) {
+  BlitQueueSync();
+
+  DisableINT(INTF_BLIT);
+  ClearIRQ(INTF_BLIT);
+  ResetIntVector(BLIT);
+}
+
+u_short BlitQueueAddNotify(const BlitCmdT *cmd, BlitNotifyT notify,
+                           void *data)
+{
+  BlitEntryT *entry;
+  u_short fence;
+
+  /* Wait for the interrupt handler to free a slot. Blit in progress holds
+   * its slot till it finishes, since its callback is stored there. */
+  while ((u_short)(bq.tail - bq.done) >= BLITQ_SIZE)
+    continue;
+
+  /* The slot is not visible to the interrupt handler till 'tail' moves. */
+  entry = &bq.entry[bq.tail & BLITQ_MASK];
+  entry->cmd = *cmd;
+  entry->notify = notify;
+  entry->data = data;
+
+  DisableINT(INTF_BLIT);
+  fence = ++bq.tail;
+  if (!bq.busy) {
+    /* The blitter may still be finishing a blit that was not queued. */
+    WaitBlitter();
+    ClearIRQ(INTF_BLIT);
+    bq.busy = true;
+    BlitterIssue(&bq.entry[bq.head & BLITQ_MASK].cmd);
+    bq.head++;
+  }
+  EnableINT(INTF_BLIT);
+
+  return fence;
+}
+
+bool BlitQueueDone(u_short fence) {
+  return ((short)(bq.done - fence) >= 0) ? true : false;
+}
+
+void BlitQueueWait(u_short fence) {
+  while ((short)(bq.done - fence) < 0)
+    continue;
+}
+
+void BlitQueueSync(void) {
+  BlitQueueWait(bq.tail);
+}
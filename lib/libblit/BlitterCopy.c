@@ -4,7 +4,7 @@ typedef struct {
   const BitmapT *src;
   const BitmapT *dst;
   u_int start;
-  u_short size;
+  BlitCmdT cmd;
 } StateT;
 
 static StateT state[1];
@@ -16,45 +16,65 @@ void BlitterCopySetup(const BitmapT *dst, u_short x, u_short y,
   /* Calculate real blit width. It can be greater than src->bytesPerRow! */
   u_short width = (x & 15) + src->width;
   u_short bytesPerRow = ((width + 15) & ~15) >> 3;
-  u_short srcmod = src->bytesPerRow - bytesPerRow;
-  u_short dstmod = dst->bytesPerRow - bytesPerRow;
-  u_short bltafwm = FirstWordMask[x & 15];
-  u_short bltalwm = LastWordMask[width & 15];
+  u_short srcmod = BitmapStride(src) - bytesPerRow;
+  u_short dstmod = BitmapStride(dst) - bytesPerRow;
   u_short bltshift = rorw(x & 15, 4);
+  BlitCmdT *cmd = &state->cmd;
 
   state->src = src;
   state->dst = dst;
-  state->start = ((x & ~15) >> 3) + y * dst->bytesPerRow;
-  state->size = (src->height << 6) | (bytesPerRow >> 1);
-
-  WaitBlitter();
+  state->start = ((x & ~15) >> 3) + y * BitmapStride(dst);
 
   if (bltshift) {
-    custom->bltcon0 = (SRCB | SRCC | DEST) | (ABC | NABC | ABNC | NANBC);
-    custom->bltbmod = srcmod;
-    custom->bltadat = -1;
-    custom->bltcmod = dstmod;
+    cmd->bltcon0 = (SRCB | SRCC | DEST) | (ABC | NABC | ABNC | NANBC);
+    cmd->bltadat = -1;
   } else {
-    custom->bltamod = 0;
-    custom->bltcon0 = (SRCA | DEST) | A_TO_D;
+    cmd->bltcon0 = (SRCA | DEST) | A_TO_D;
   }
 
-  custom->bltcon1 = bltshift;
-  custom->bltafwm = bltafwm;
-  custom->bltalwm = bltalwm;
-  custom->bltdmod = dstmod;
+  cmd->bltcon1 = bltshift;
+  cmd->bltafwm = FirstWordMask[x & 15];
+  cmd->bltalwm = LastWordMask[width & 15];
+  cmd->bltamod = srcmod;
+  cmd->bltbmod = srcmod;
+  cmd->bltcmod = dstmod;
+  cmd->bltdmod = dstmod;
+  cmd->bltsize = (src->height << 6) | (bytesPerRow >> 1);
 }
 
 void BlitterCopyStart(short dstbpl, short srcbpl) {
+  BlitCmdT *cmd = &state->cmd;
   void *srcbpt = state->src->planes[srcbpl];
   void *dstbpt = state->dst->planes[dstbpl] + state->start;
-  u_short bltsize = state->size;
 
   WaitBlitter();
 
+  if (cmd->bltcon1) {
+    custom->bltbmod = cmd->bltbmod;
+    custom->bltadat = -1;
+    custom->bltcmod = cmd->bltcmod;
+  } else {
+    custom->bltamod = cmd->bltamod;
+  }
+
+  custom->bltcon0 = cmd->bltcon0;
+  custom->bltcon1 = cmd->bltcon1;
+  custom->bltafwm = cmd->bltafwm;
+  custom->bltalwm = cmd->bltalwm;
+  custom->bltdmod = cmd->bltdmod;
   custom->bltapt = srcbpt;
   custom->bltbpt = srcbpt;
   custom->bltcpt = dstbpt;
   custom->bltdpt = dstbpt;
-  custom->bltsize = bltsize;
+  custom->bltsize = cmd->bltsize;
+}
+
+const BlitCmdT *BlitterCopyCmd(short dstbpl, short srcbpl) {
+  BlitCmdT *cmd = &state->cmd;
+
+  cmd->bltapt = state->src->planes[srcbpl];
+  cmd->bltbpt = cmd->bltapt;
+  cmd->bltcpt = state->dst->planes[dstbpl] + state->start;
+  cmd->bltdpt = cmd->bltcpt;
+  return cmd;
 }
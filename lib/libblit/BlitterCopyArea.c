@@ -5,8 +5,8 @@ typedef struct {
   const BitmapT *dst;
   u_int src_start;
   u_int dst_start;
-  u_short size;
   bool fast;
+  BlitCmdT cmd;
 } StateT;
 
 static StateT state[1];
@@ -33,11 +33,12 @@ void BlitterCopyAreaSetup(const BitmapT *dst, u_short dx, u_short dy,
   u_short width = xo + sw;
   u_short wo = width & 15;
   u_short bytesPerRow = ALIGN(width);
-  u_short srcmod = src->bytesPerRow - bytesPerRow;
-  u_short dstmod = dst->bytesPerRow - bytesPerRow;
+  u_short srcmod = BitmapStride(src) - bytesPerRow;
+  u_short dstmod = BitmapStride(dst) - bytesPerRow;
   u_short bltafwm = FirstWordMask[dxo];
   u_short bltalwm = LastWordMask[wo];
   u_short bltshift = rorw(xo, 4);
+  BlitCmdT *cmd = &state->cmd;
 
   /*
    * TODO: Two cases exist where number of word for 'src' and 'dst' differ.
@@ -51,63 +52,90 @@ void BlitterCopyAreaSetup(const BitmapT *dst, u_short dx, u_short dy,
   state->dst = dst;
   state->src_start = START(sx);
   state->dst_start = START(dx);
-  state->size = (sh << 6) | (bytesPerRow >> 1);
+  cmd->bltsize = (sh << 6) | (bytesPerRow >> 1);
 
   if (forward) {
-    state->src_start += (short)sy * (short)src->bytesPerRow;
-    state->dst_start += (short)dy * (short)dst->bytesPerRow;
+    state->src_start += (short)sy * BitmapStride(src);
+    state->dst_start += (short)dy * BitmapStride(dst);
   } else {
-    state->src_start += (short)(sy + sh - 1) * (short)src->bytesPerRow
+    state->src_start += (short)(sy + sh - 1) * BitmapStride(src)
                       + bytesPerRow - 2;
-    state->dst_start += (short)(dy + sh - 1) * (short)dst->bytesPerRow
+    state->dst_start += (short)(dy + sh - 1) * BitmapStride(dst)
                       + bytesPerRow - 2;
   }
 
   state->fast = (xo == 0) && (wo == 0);
 
-  WaitBlitter();
-
   if (!state->fast) {
-    custom->bltcon0 = (SRCB | SRCC | DEST) | (ABC | NABC | ABNC | NANBC);
-    custom->bltcon1 = bltshift | (forward ? 0 : BLITREVERSE);
-    custom->bltadat = -1;
+    cmd->bltcon0 = (SRCB | SRCC | DEST) | (ABC | NABC | ABNC | NANBC);
+    cmd->bltcon1 = bltshift | (forward ? 0 : BLITREVERSE);
+    cmd->bltadat = -1;
     if (forward) {
-      custom->bltafwm = bltafwm;
-      custom->bltalwm = bltalwm;
+      cmd->bltafwm = bltafwm;
+      cmd->bltalwm = bltalwm;
     } else {
-      custom->bltafwm = bltalwm;
-      custom->bltalwm = bltafwm;
+      cmd->bltafwm = bltalwm;
+      cmd->bltalwm = bltafwm;
     }
-    custom->bltbmod = srcmod;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
+    cmd->bltbmod = srcmod;
+    cmd->bltcmod = dstmod;
+    cmd->bltdmod = dstmod;
   } else {
-    custom->bltcon0 = (SRCA | DEST) | A_TO_D;
-    custom->bltcon1 = 0;
-    custom->bltafwm = -1;
-    custom->bltalwm = -1;
-    custom->bltamod = srcmod;
-    custom->bltdmod = dstmod;
+    cmd->bltcon0 = (SRCA | DEST) | A_TO_D;
+    cmd->bltcon1 = 0;
+    cmd->bltafwm = -1;
+    cmd->bltalwm = -1;
+    cmd->bltamod = srcmod;
+    cmd->bltdmod = dstmod;
   }
 }
 
 void BlitterCopyAreaStart(short dstbpl, short srcbpl) {
+  BlitCmdT *cmd = &state->cmd;
   void *srcbpt = state->src->planes[srcbpl] + state->src_start;
   void *dstbpt = state->dst->planes[dstbpl] + state->dst_start;
-  u_short bltsize = state->size;
 
   if (state->fast) {
     WaitBlitter();
 
+    custom->bltcon0 = cmd->bltcon0;
+    custom->bltcon1 = 0;
+    custom->bltafwm = -1;
+    custom->bltalwm = -1;
+    custom->bltamod = cmd->bltamod;
+    custom->bltdmod = cmd->bltdmod;
     custom->bltapt = srcbpt;
     custom->bltdpt = dstbpt;
-    custom->bltsize = bltsize;
+    custom->bltsize = cmd->bltsize;
   } else {
     WaitBlitter();
 
+    custom->bltcon0 = cmd->bltcon0;
+    custom->bltcon1 = cmd->bltcon1;
+    custom->bltadat = -1;
+    custom->bltafwm = cmd->bltafwm;
+    custom->bltalwm = cmd->bltalwm;
+    custom->bltbmod = cmd->bltbmod;
+    custom->bltcmod = cmd->bltcmod;
+    custom->bltdmod = cmd->bltdmod;
     custom->bltbpt = srcbpt;
     custom->bltcpt = dstbpt;
     custom->bltdpt = dstbpt;
-    custom->bltsize = bltsize;
+    custom->bltsize = cmd->bltsize;
+  }
+}
+
+const BlitCmdT *BlitterCopyAreaCmd(short dstbpl, short srcbpl) {
+  BlitCmdT *cmd = &state->cmd;
+  void *srcbpt = state->src->planes[srcbpl] + state->src_start;
+  void *dstbpt = state->dst->planes[dstbpl] + state->dst_start;
+
+  if (state->fast) {
+    cmd->bltapt = srcbpt;
+  } else {
+    cmd->bltbpt = srcbpt;
+    cmd->bltcpt = dstbpt;
   }
+  cmd->bltdpt = dstbpt;
+  return cmd;
 }
@@ -4,7 +4,7 @@ typedef struct {
   const BitmapT *src;
   const BitmapT *dst;
   u_int start;
-  u_short size;
+  BlitCmdT cmd;
 } StateT;
 
 static StateT state[1];
@@ -12,42 +12,56 @@ static StateT state[1];
 void BlitterCopyFastSetup(const BitmapT *dst, u_short x, u_short y,
                           const BitmapT *src) 
 {
-  u_short dstmod = dst->bytesPerRow - src->bytesPerRow;
+  u_short srcmod = BitmapStride(src) - src->bytesPerRow;
+  u_short dstmod = BitmapStride(dst) - src->bytesPerRow;
   u_short bltshift = rorw(x & 15, 4);
   u_short bltsize = (src->height << 6) | (src->bytesPerRow >> 1);
+  BlitCmdT *cmd = &state->cmd;
 
   if (bltshift)
     bltsize++, dstmod -= 2;
 
   state->src = src;
   state->dst = dst;
-  state->start = ((x & ~15) >> 3) + y * dst->bytesPerRow;
-  state->size = bltsize;
-
-  WaitBlitter();
+  state->start = ((x & ~15) >> 3) + y * BitmapStride(dst);
 
   if (bltshift) {
-    custom->bltalwm = 0;
-    custom->bltamod = -2;
+    cmd->bltalwm = 0;
+    cmd->bltamod = srcmod - 2;
   } else {
-    custom->bltalwm = -1;
-    custom->bltamod = 0;
+    cmd->bltalwm = -1;
+    cmd->bltamod = srcmod;
   }
 
-  custom->bltdmod = dstmod;
-  custom->bltcon0 = (SRCA | DEST | A_TO_D) | bltshift;
-  custom->bltcon1 = 0;
-  custom->bltafwm = -1;
+  cmd->bltdmod = dstmod;
+  cmd->bltcon0 = (SRCA | DEST | A_TO_D) | bltshift;
+  cmd->bltcon1 = 0;
+  cmd->bltafwm = -1;
+  cmd->bltsize = bltsize;
 }
 
 void BlitterCopyFastStart(short dstbpl, short srcbpl) {
+  BlitCmdT *cmd = &state->cmd;
   void *srcbpt = state->src->planes[srcbpl];
   void *dstbpt = state->dst->planes[dstbpl] + state->start;
-  u_short bltsize = state->size;
 
   WaitBlitter();
 
+  custom->bltalwm = cmd->bltalwm;
+  custom->bltamod = cmd->bltamod;
+  custom->bltdmod = cmd->bltdmod;
+  custom->bltcon0 = cmd->bltcon0;
+  custom->bltcon1 = 0;
+  custom->bltafwm = -1;
   custom->bltapt = srcbpt;
   custom->bltdpt = dstbpt;
-  custom->bltsize = bltsize;
+  custom->bltsize = cmd->bltsize;
+}
+
+const BlitCmdT *BlitterCopyFastCmd(short dstbpl, short srcbpl) {
+  BlitCmdT *cmd = &state->cmd;
+
+  cmd->bltapt = state->src->planes[srcbpl];
+  cmd->bltdpt = state->dst->planes[dstbpl] + state->start;
+  return cmd;
 }
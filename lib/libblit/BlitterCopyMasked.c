@@ -5,7 +5,7 @@ typedef struct {
   const BitmapT *msk;
   const BitmapT *dst;
   u_int start;
-  u_short size;
+  BlitCmdT cmd;
 } StateT;
 
 static StateT state[1];
@@ -13,52 +13,70 @@ static StateT state[1];
 void BlitterCopyMaskedSetup(const BitmapT *dst, u_short x, u_short y,
                             const BitmapT *src, const BitmapT *msk)
 {
-  u_short dstmod = dst->bytesPerRow - src->bytesPerRow;
+  u_short srcmod = BitmapStride(src) - src->bytesPerRow;
+  u_short mskmod = BitmapStride(msk) - src->bytesPerRow;
+  u_short dstmod = BitmapStride(dst) - src->bytesPerRow;
   u_short bltsize = (src->height << 6) | (src->bytesPerRow >> 1);
   u_short bltshift = rorw(x & 15, 4);
+  BlitCmdT *cmd = &state->cmd;
 
   state->src = src;
   state->dst = dst;
   state->msk = msk;
-  state->start = ((x & ~15) >> 3) + y * dst->bytesPerRow;
+  state->start = ((x & ~15) >> 3) + y * BitmapStride(dst);
 
   if (bltshift)
     bltsize++, dstmod -= 2;
 
-  WaitBlitter();
-
   if (bltshift) {
-    custom->bltamod = -2;
-    custom->bltbmod = -2;
-    custom->bltcon0 = (SRCA | SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NANBC) | bltshift;
-    custom->bltcon1 = bltshift;
-    custom->bltalwm = 0;
-    custom->bltafwm = -1;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
+    cmd->bltamod = srcmod - 2;
+    cmd->bltbmod = mskmod - 2;
+    cmd->bltcon0 = (SRCA | SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NANBC) | bltshift;
+    cmd->bltcon1 = bltshift;
+    cmd->bltalwm = 0;
   } else {
-    custom->bltamod = 0;
-    custom->bltbmod = 0;
-    custom->bltcon0 = (SRCA | SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NANBC);
-    custom->bltcon1 = 0;
-    custom->bltalwm = -1;
-    custom->bltafwm = -1;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
+    cmd->bltamod = srcmod;
+    cmd->bltbmod = mskmod;
+    cmd->bltcon0 = (SRCA | SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NANBC);
+    cmd->bltcon1 = 0;
+    cmd->bltalwm = -1;
   }
+
+  cmd->bltafwm = -1;
+  cmd->bltcmod = dstmod;
+  cmd->bltdmod = dstmod;
+  cmd->bltsize = bltsize;
 }
 
 void BlitterCopyMaskedStart(short dstbpl, short srcbpl) {
+  BlitCmdT *cmd = &state->cmd;
   void *srcbpt = state->src->planes[srcbpl];
   void *dstbpt = state->dst->planes[dstbpl] + state->start;
   void *mskbpt = state->msk->planes[0];
-  u_short bltsize = state->size;
 
   WaitBlitter();
 
+  custom->bltamod = cmd->bltamod;
+  custom->bltbmod = cmd->bltbmod;
+  custom->bltcon0 = cmd->bltcon0;
+  custom->bltcon1 = cmd->bltcon1;
+  custom->bltalwm = cmd->bltalwm;
+  custom->bltafwm = -1;
+  custom->bltcmod = cmd->bltcmod;
+  custom->bltdmod = cmd->bltdmod;
   custom->bltapt = srcbpt;
   custom->bltbpt = mskbpt;
   custom->bltcpt = dstbpt;
   custom->bltdpt = dstbpt;
-  custom->bltsize = bltsize;
+  custom->bltsize = cmd->bltsize;
+}
+
+const BlitCmdT *BlitterCopyMaskedCmd(short dstbpl, short srcbpl) {
+  BlitCmdT *cmd = &state->cmd;
+
+  cmd->bltapt = state->src->planes[srcbpl];
+  cmd->bltbpt = state->msk->planes[0];
+  cmd->bltcpt = state->dst->planes[dstbpl] + state->start;
+  cmd->bltdpt = cmd->bltcpt;
+  return cmd;
 }
@@ -1,7 +1,10 @@
 #include <blitter.h>
 
-void BlitterFillArea(const BitmapT *bitmap, short plane, const Area2D *area) {
+static void FillAreaSetup(BlitCmdT *cmd, const BitmapT *bitmap, short plane,
+                          const Area2D *area, u_short mode)
+{
   void *bltpt = bitmap->planes[plane];
+  short stride = BitmapStride(bitmap);
   u_short bltmod, bltsize;
 
   if (area) {
@@ -10,27 +13,54 @@ void BlitterFillArea(const BitmapT *bitmap, short plane, const Area2D *area) {
     short w = area->w;
     short h = area->h;
 
-    bltpt += (((x + w) >> 3) & ~1) + (short)(y + h) * (short)bitmap->bytesPerRow;
+    bltpt += (((x + w) >> 3) & ~1) + (short)(y + h) * stride;
     w >>= 3;
-    bltmod = bitmap->bytesPerRow - w;
+    bltmod = stride - w;
     bltsize = (h << 6) | (w >> 1);
   } else {
-    bltpt += bitmap->bplSize;
-    bltmod = 0;
+    bltpt += (short)(bitmap->height - 1) * stride + bitmap->bytesPerRow;
+    bltmod = stride - bitmap->bytesPerRow;
     bltsize = (bitmap->height << 6) | (bitmap->bytesPerRow >> 1);
   }
 
   bltpt -= 2;
 
+  cmd->bltapt = bltpt;
+  cmd->bltdpt = bltpt;
+  cmd->bltamod = bltmod;
+  cmd->bltdmod = bltmod;
+  cmd->bltcon0 = (SRCA | DEST) | A_TO_D;
+  cmd->bltcon1 = BLITREVERSE | mode;
+  cmd->bltafwm = -1;
+  cmd->bltalwm = -1;
+  cmd->bltsize = bltsize;
+}
+
+void BlitterFillArea(const BitmapT *bitmap, short plane, const Area2D *area,
+                     u_short mode)
+{
+  BlitCmdT cmd;
+
+  FillAreaSetup(&cmd, bitmap, plane, area, mode);
+
   WaitBlitter();
 
-  custom->bltapt = bltpt;
-  custom->bltdpt = bltpt;
-  custom->bltamod = bltmod;
-  custom->bltdmod = bltmod;
-  custom->bltcon0 = (SRCA | DEST) | A_TO_D;
-  custom->bltcon1 = BLITREVERSE | FILL_OR;
+  custom->bltapt = cmd.bltapt;
+  custom->bltdpt = cmd.bltdpt;
+  custom->bltamod = cmd.bltamod;
+  custom->bltdmod = cmd.bltdmod;
+  custom->bltcon0 = cmd.bltcon0;
+  custom->bltcon1 = cmd.bltcon1;
   custom->bltafwm = -1;
   custom->bltalwm = -1;
-  custom->bltsize = bltsize;
+  custom->bltsize = cmd.bltsize;
+}
+
+const BlitCmdT *BlitterFillAreaCmd(const BitmapT *bitmap, short plane,
+                                   const Area2D *area, u_short mode)
+{
+  static BlitCmdT cmd;
+
+  FillAreaSetup(&cmd, bitmap, plane, area, mode);
+  return &cmd;
 }
@@ -42,6 +42,7 @@ struct {
   short stride;
   u_short bltcon0;
   u_short bltcon1;
+  u_short pattern;
 } line[1];
 
 void BlitterLineSetupFull(const BitmapT *bitmap, u_short plane,
@@ -49,9 +50,10 @@ void BlitterLineSetupFull(const BitmapT *bitmap, u_short plane,
 {
   line->data = bitmap->planes[plane];
   line->scratch = bitmap->planes[bitmap->depth];
-  line->stride = bitmap->bytesPerRow;
+  line->stride = BitmapStride(bitmap);
   line->bltcon0 = LineMode[mode][0];
   line->bltcon1 = LineMode[mode][1];
+  line->pattern = pattern;
 
   WaitBlitter();
 
@@ -63,7 +65,9 @@ void BlitterLineSetupFull(const BitmapT *bitmap, u_short plane,
   custom->bltdmod = line->stride;
 }
 
-void BlitterLine(short x1 asm("d2"), short y1 asm("d3"), short x2 asm("d4"), short y2 asm("d5")) {
+static inline void LinePrepare(LineCmdT *cmd, short x1, short y1,
+                               short x2, short y2)
+{
   u_char *data = line->data;
   u_short bltcon1 = line->bltcon1;
   short dx, dy, derr;
@@ -101,22 +105,122 @@ void BlitterLine(short x1 asm("d2"), short y1 asm("d3"), short x2 asm("d4"), sho
   if (derr < 0)
     bltcon1 |= SIGNFLAG;
 
-  {
-    u_short bltcon0 = rorw(x1 & 15, 4) | line->bltcon0;
-    u_short bltamod = derr - dx;
-    u_short bltbmod = dy + dy;
-    void *bltdpt = (bltcon1 & ONEDOT) ? line->scratch : data;
-    u_short bltsize = (dx << 6) + 66;
+  cmd->bltcon0 = rorw(x1 & 15, 4) | line->bltcon0;
+  cmd->bltcon1 = bltcon1;
+  cmd->bltamod = derr - dx;
+  cmd->bltbmod = dy + dy;
+  cmd->bltapt = (void *)(int)derr;
+  cmd->bltcpt = data;
+  cmd->bltdpt = (bltcon1 & ONEDOT) ? line->scratch : data;
+  cmd->bltsize = (dx << 6) + 66;
+}
+
+static inline void LineStart(const LineCmdT *cmd) {
+  WaitBlitter();
+
+  custom->bltcon0 = cmd->bltcon0;
+  custom->bltcon1 = cmd->bltcon1;
+  custom->bltamod = cmd->bltamod;
+  custom->bltbmod = cmd->bltbmod;
+  custom->bltapt = cmd->bltapt;
+  custom->bltcpt = cmd->bltcpt;
+  custom->bltdpt = cmd->bltdpt;
+  custom->bltsize = cmd->bltsize;
+}
+
+void BlitterLine(short x1 asm("d2"), short y1 asm("d3"), short x2 asm("d4"), short y2 asm("d5")) {
+  LineCmdT cmd;
+
+  LinePrepare(&cmd, x1, y1, x2, y2);
+  LineStart(&cmd);
+}
+
+void BlitterLinePrepare(LineCmdT *cmd, const Line2D *lines, short n) {
+  while (--n >= 0) {
+    LinePrepare(cmd++, lines->x1, lines->y1, lines->x2, lines->y2);
+    lines++;
+  }
+}
+
+short BlitterLinePrepareEdges(LineCmdT *cmd, const void *point,
+                              const EdgeT *edge, const char *flags, short n)
+{
+  short count = 0;
+
+  while (--n >= 0) {
+    if (!flags || *flags++) {
+      const short *p0 = point + edge->p0;
+      const short *p1 = point + edge->p1;
+      LinePrepare(cmd++, p0[0], p0[1], p1[0], p1[1]);
+      count++;
+    }
+    edge++;
+  }
+
+  return count;
+}
+
+/*
+ * Nothing is calculated between lines, so the blitter gets next line as soon
+ * as it finishes previous one. Registers that are the same for all lines were
+ * loaded by BlitterLineSetup. Pointers are advanced by the blitter and size
+ * starts the line, so these are always written. The rest is written only if
+ * it differs from previous line.
+ */
+void BlitterLineBatch(const LineCmdT *cmd, short n) {
+  const LineCmdT *prev;
+
+  if (n <= 0)
+    return;
+
+  LineStart(cmd);
+
+  while (--n > 0) {
+    prev = cmd++;
 
     WaitBlitter();
 
-    custom->bltcon0 = bltcon0;
-    custom->bltcon1 = bltcon1;
-    custom->bltamod = bltamod;
-    custom->bltbmod = bltbmod;
-    custom->bltapt = (void *)(int)derr;
-    custom->bltcpt = data;
-    custom->bltdpt = bltdpt;
-    custom->bltsize = bltsize;
+    if (cmd->bltcon0 != prev->bltcon0)
+      custom->bltcon0 = cmd->bltcon0;
+    if (cmd->bltcon1 != prev->bltcon1)
+      custom->bltcon1 = cmd->bltcon1;
+    if (cmd->bltamod != prev->bltamod)
+      custom->bltamod = cmd->bltamod;
+    if (cmd->bltbmod != prev->bltbmod)
+      custom->bltbmod = cmd->bltbmod;
+    custom->bltapt = cmd->bltapt;
+    custom->bltcpt = cmd->bltcpt;
+    custom->bltdpt = cmd->bltdpt;
+    custom->bltsize = cmd->bltsize;
   }
 }
+
+u_short BlitterLineQueue(const LineCmdT *cmd, short n) {
+  BlitCmdT blit;
+  u_short fence = 0;
+
+  /* Other queued blits may change any register, so each line loads all. */
+  blit.bltafwm = -1;
+  blit.bltalwm = -1;
+  blit.bltadat = 0x8000;
+  blit.bltbdat = line->pattern;
+  blit.bltcdat = 0;
+  blit.bltcmod = line->stride;
+  blit.bltdmod = line->stride;
+
+  while (--n >= 0) {
+    blit.bltcon0 = cmd->bltcon0;
+    blit.bltcon1 = cmd->bltcon1;
+    blit.bltamod = cmd->bltamod;
+    blit.bltbmod = cmd->bltbmod;
+    blit.bltapt = cmd->bltapt;
+    blit.bltbpt = NULL;
+    blit.bltcpt = cmd->bltcpt;
+    blit.bltdpt = cmd->bltdpt;
+    blit.bltsize = cmd->bltsize;
+    fence = BlitQueueAdd(&blit);
+    cmd++;
+  }
+
+  return fence;
+}
@@ -3,7 +3,7 @@
 typedef struct {
   const BitmapT *bitmap;
   u_int start;
-  u_short size;
+  BlitCmdT cmd;
 } StateT;
 
 static StateT state[1];
@@ -11,47 +11,62 @@ static StateT state[1];
 /* Supports any area dimensions,
  * but is optimized for 'x' and 'w' divisible by 16. */
 void BlitterSetAreaSetup(const BitmapT *bitmap, const Area2D *area) {
-  u_short bltafwm, bltalwm, bltmod, bytesPerRow;
+  u_short bltmod, bytesPerRow;
   u_short x = 0, y = 0, width = bitmap->width, height = bitmap->height;
+  BlitCmdT *cmd = &state->cmd;
 
   if (area)
     x = area->x, y = area->y, width = area->w, height = area->h;
 
   width += x & 15;
   bytesPerRow = ((width + 15) & ~15) >> 3;
-
-  bltafwm = FirstWordMask[x & 15];
-  bltalwm = LastWordMask[width & 15];
-  bltmod = bitmap->bytesPerRow - bytesPerRow;
+  bltmod = BitmapStride(bitmap) - bytesPerRow;
 
   state->bitmap = bitmap;
-  state->start = ((x & ~15) >> 3) + y * bitmap->bytesPerRow;
-  state->size = (height << 6) | (bytesPerRow >> 1);
-
-  WaitBlitter();
+  state->start = ((x & ~15) >> 3) + y * BitmapStride(bitmap);
 
   if ((x & 15) || (width & 15)) {
-    custom->bltadat = -1;
-    custom->bltbmod = bltmod;
-    custom->bltcon0 = (SRCB | DEST) | (NABC | NABNC | ABC | ANBC);
+    cmd->bltadat = -1;
+    cmd->bltbmod = bltmod;
+    cmd->bltcon0 = (SRCB | DEST) | (NABC | NABNC | ABC | ANBC);
   } else {
-    custom->bltcon0 = DEST | C_TO_D;
+    cmd->bltcon0 = DEST | C_TO_D;
   }
 
-  custom->bltcon1 = 0;
-  custom->bltdmod = bltmod;
-  custom->bltafwm = bltafwm;
-  custom->bltalwm = bltalwm;
+  cmd->bltcon1 = 0;
+  cmd->bltdmod = bltmod;
+  cmd->bltafwm = FirstWordMask[x & 15];
+  cmd->bltalwm = LastWordMask[width & 15];
+  cmd->bltsize = (height << 6) | (bytesPerRow >> 1);
 }
 
 void BlitterSetAreaStart(short bplnum, u_short pattern) {
+  BlitCmdT *cmd = &state->cmd;
   void *bltpt = state->bitmap->planes[bplnum] + state->start;
-  u_short bltsize = state->size;
 
   WaitBlitter();
 
+  if (cmd->bltcon0 & SRCB) {
+    custom->bltadat = -1;
+    custom->bltbmod = cmd->bltbmod;
+  }
+
+  custom->bltcon0 = cmd->bltcon0;
+  custom->bltcon1 = 0;
+  custom->bltdmod = cmd->bltdmod;
+  custom->bltafwm = cmd->bltafwm;
+  custom->bltalwm = cmd->bltalwm;
   custom->bltcdat = pattern;
   custom->bltbpt = bltpt;
   custom->bltdpt = bltpt;
-  custom->bltsize = bltsize;
+  custom->bltsize = cmd->bltsize;
+}
+
+const BlitCmdT *BlitterSetAreaCmd(short bplnum, u_short pattern) {
+  BlitCmdT *cmd = &state->cmd;
+
+  cmd->bltcdat = pattern;
+  cmd->bltbpt = state->bitmap->planes[bplnum] + state->start;
+  cmd->bltdpt = cmd->bltbpt;
+  return cmd;
 }
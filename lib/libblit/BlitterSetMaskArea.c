@@ -15,16 +15,16 @@ void BlitterSetMaskArea(const BitmapT *dst, short dstbpl, u_short x, u_short y,
     short mh = area->h;
     short bytesPerRow = ((mw + 15) & ~15) >> 3;
 
-    dstbpt += ((x >> 3) & ~1) + (short)y * (short)dst->bytesPerRow;
-    mskbpt += ((mx >> 3) & ~1) + (short)my * (short)msk->bytesPerRow;
-    dstmod = dst->bytesPerRow - bytesPerRow;
-    mskmod = msk->bytesPerRow - bytesPerRow;
+    dstbpt += ((x >> 3) & ~1) + (short)y * BitmapStride(dst);
+    mskbpt += ((mx >> 3) & ~1) + (short)my * BitmapStride(msk);
+    dstmod = BitmapStride(dst) - bytesPerRow;
+    mskmod = BitmapStride(msk) - bytesPerRow;
     bltsize = (mh << 6) | (bytesPerRow >> 1);
     bltshift = rorw(x & 15, 4);
   } else {
-    dstbpt += ((x >> 3) & ~1) + y * dst->bytesPerRow;
-    dstmod = dst->bytesPerRow - msk->bytesPerRow;
-    mskmod = dstmod;
+    dstbpt += ((x >> 3) & ~1) + y * BitmapStride(dst);
+    dstmod = BitmapStride(dst) - msk->bytesPerRow;
+    mskmod = BitmapStride(msk) - msk->bytesPerRow;
     bltsize = (msk->height << 6) | (msk->bytesPerRow >> 1);
     bltshift = rorw(x & 15, 4);
   }
@@ -48,7 +48,7 @@ void BlitterSetMaskArea(const BitmapT *dst, short dstbpl, u_short x, u_short y,
     custom->bltafwm = -1;
     custom->bltsize = bltsize;
   } else {
-    custom->bltbmod = 0;
+    custom->bltbmod = mskmod;
     custom->bltcon0 = (SRCB|SRCC|DEST) | (ABC|ABNC|ANBC|NANBC);
     custom->bltcon1 = 0;
     custom->bltalwm = -1;
@@ -0,0 +1,248 @@
+#include <memory.h>
+#include <blitter.h>
+#include <bob.h>
+
+BobsT *NewBobs(const BitmapT *background, short count) {
+  BobsT *bobs = MemAlloc(sizeof(BobsT), MEMF_PUBLIC);
+
+  bobs->background = background;
+  bobs->count = count;
+  bobs->bob = MemAlloc(sizeof(BobT) * count, MEMF_PUBLIC|MEMF_CLEAR);
+  bobs->area = MemAlloc(sizeof(Area2D) * count, MEMF_PUBLIC);
+
+  return bobs;
+}
+
+void DeleteBobs(BobsT *bobs) {
+  if (bobs) {
+    MemFree(bobs->area);
+    MemFree(bobs->bob);
+    MemFree(bobs);
+  }
+}
+
+/* Dirty areas are word aligned, so size is measured in words. */
+static inline int AreaSize(const Area2D *a) {
+  return (short)(a->w >> 4) * a->h;
+}
+
+/*
+ * Merge is worth it only if union of both areas is not greater than their
+ * areas summed, i.e. what is restored twice makes up for what gets restored
+ * in vain.
+ */
+static bool MergeArea(Area2D *a, const Area2D *b) {
+  short x0, y0, x1, y1;
+  Area2D u;
+
+  if (a->x >= b->x + b->w || b->x >= a->x + a->w)
+    return false;
+  if (a->y >= b->y + b->h || b->y >= a->y + a->h)
+    return false;
+
+  x0 = min(a->x, b->x);
+  y0 = min(a->y, b->y);
+  x1 = max(a->x + a->w, b->x + b->w);
+  y1 = max(a->y + a->h, b->y + b->h);
+
+  u.x = x0;
+  u.y = y0;
+  u.w = x1 - x0;
+  u.h = y1 - y0;
+
+  if (AreaSize(&u) > AreaSize(a) + AreaSize(b))
+    return false;
+
+  *a = u;
+  return true;
+}
+
+static short AddArea(Area2D *area, short n, const Area2D *dirty) {
+  Area2D a = *dirty;
+  short i = 0;
+
+  /* Grown area may overlap those that were checked before. */
+  while (i < n) {
+    if (MergeArea(&a, &area[i])) {
+      area[i] = area[--n];
+      i = 0;
+    } else {
+      i++;
+    }
+  }
+
+  area[n++] = a;
+  return n;
+}
+
+void BobsRestore(BobsT *bobs, const BitmapT *screen, short buffer) {
+  const BitmapT *background = bobs->background;
+  Area2D *area = bobs->area;
+  BobT *bob = bobs->bob;
+  short n = bobs->count;
+  short m = 0;
+
+  while (--n >= 0) {
+    Area2D *dirty = &bob->dirty[buffer];
+    if (dirty->h > 0) {
+      m = AddArea(area, m, dirty);
+      dirty->h = 0;
+    }
+    bob++;
+  }
+
+  while (--m >= 0) {
+    BitmapCopyArea(screen, area->x, area->y, background, area);
+    area++;
+  }
+}
+
+/*
+ * Mask goes through channel A, so last word mask cuts off shifted out bits.
+ * The shifter carries bits of the last word of a row into the first word of
+ * the next row. The last word mask keeps only the bits that the last word
+ * puts into its own destination word, so the carry is always empty. That also
+ * lets bobs be clipped at screen edges by skipping words on either side.
+ *
+ * In ascending mode the first visible word needs bits of the word on its left.
+ * If bob is shifted and sticks out on the left, that word is not fetched, so
+ * the blit runs in descending mode, where the carry goes from right to left.
+ *
+ * Without mask the image goes through channel A instead and is or'ed into
+ * screen, so the same masks and shifts apply.
+ *
+ * If screen, image and mask are all interleaved, one blit draws all bitplanes.
+ */
+static void BobDraw(BobT *bob, const BitmapT *screen, short buffer) {
+  const BitmapT *bitmap = bob->bitmap;
+  const BitmapT *mask = bob->mask;
+  short x = bob->x;
+  short y = bob->y;
+  short h = bitmap->height;
+  short shift = x & 15;
+  short first = x >> 4;
+  short last = first + (bitmap->bytesPerRow >> 1) - (shift ? 0 : 1);
+  short left = max(first, 0);
+  short right = min(last, (short)(screen->width >> 4) - 1);
+  short sx, sy = 0;
+  short words, srcrow, mskrow = 0, dstrow;
+  u_short bltshift, bltcon0, bltcon1, bltalwm;
+  u_short srcmod, mskmod, dstmod;
+  u_int srcstart, mskstart = 0, dststart;
+  short i, depth;
+
+  if (left > right)
+    return;
+
+  if (y < 0)
+    sy = -y, h += y, y = 0;
+  if (y + h > screen->height)
+    h = screen->height - y;
+  if (h <= 0)
+    return;
+
+  if (shift && left > first) {
+    /* Descending mode would lose the carry on the right side. */
+    if (right < last)
+      return;
+    bltcon1 = BLITREVERSE;
+    bltalwm = (1 << shift) - 1;
+    bltshift = rorw(16 - shift, 4);
+    sx = left - first - 1;
+  } else {
+    bltcon1 = 0;
+    bltalwm = (shift && right == last) ? 0 : (u_short)(0xffff << shift);
+    bltshift = rorw(shift, 4);
+    sx = left - first;
+  }
+
+  words = right - left + 1;
+
+  {
+    Area2D *dirty = &bob->dirty[buffer];
+    dirty->x = left << 4;
+    dirty->y = y;
+    dirty->w = words << 4;
+    dirty->h = h;
+  }
+
+  srcstart = sy * BitmapStride(bitmap) + (sx << 1);
+  dststart = y * BitmapStride(screen) + (left << 1);
+  depth = min(screen->depth, bitmap->depth);
+
+  if (mask)
+    mskstart = sy * BitmapStride(mask) + (sx << 1);
+
+  if (BitmapsInterleaved(screen, bitmap) &&
+      (!mask || BitmapsInterleaved(bitmap, mask)) &&
+      h * depth <= BLIT_MAXROWS) {
+    srcrow = bitmap->bytesPerRow;
+    dstrow = screen->bytesPerRow;
+    if (mask)
+      mskrow = mask->bytesPerRow;
+    h *= depth;
+    depth = 1;
+  } else {
+    srcrow = BitmapStride(bitmap);
+    dstrow = BitmapStride(screen);
+    if (mask)
+      mskrow = BitmapStride(mask);
+  }
+
+  srcmod = srcrow - (words << 1);
+  mskmod = mskrow - (words << 1);
+  dstmod = dstrow - (words << 1);
+
+  /* Descending blit starts with the last word of the last row. */
+  if (bltcon1 & BLITREVERSE) {
+    short offset = (words - 1) << 1;
+    srcstart += (short)(h - 1) * srcrow + offset;
+    mskstart += (short)(h - 1) * mskrow + offset;
+    dststart += (short)(h - 1) * dstrow + offset;
+  }
+
+  if (mask) {
+    bltcon0 = (SRCA | SRCB | SRCC | DEST) |
+              (ABC | ABNC | NABC | NANBC) | bltshift;
+    bltcon1 |= bltshift;
+  } else {
+    bltcon0 = (SRCA | SRCC | DEST) | A_OR_C | bltshift;
+  }
+
+  for (i = 0; i < depth; i++) {
+    void *srcbpt = bitmap->planes[i] + srcstart;
+    void *dstbpt = screen->planes[i] + dststart;
+
+    WaitBlitter();
+
+    custom->bltcon0 = bltcon0;
+    custom->bltcon1 = bltcon1;
+    custom->bltafwm = -1;
+    custom->bltalwm = bltalwm;
+    if (mask) {
+      custom->bltamod = mskmod;
+      custom->bltbmod = srcmod;
+      custom->bltapt = mask->planes[0] + mskstart;
+      custom->bltbpt = srcbpt;
+    } else {
+      custom->bltamod = srcmod;
+      custom->bltapt = srcbpt;
+    }
+    custom->bltcmod = dstmod;
+    custom->bltdmod = dstmod;
+    custom->bltcpt = dstbpt;
+    custom->bltdpt = dstbpt;
+    custom->bltsize = (h << 6) | words;
+  }
+}
+
+void BobsDraw(BobsT *bobs, const BitmapT *screen, short buffer) {
+  BobT *bob = bobs->bob;
+  short n = bobs->count;
+
+  while (--n >= 0) {
+    if (bob->visible)
+      BobDraw(bob, screen, buffer);
+    bob++;
+  }
+}
@@ -0,0 +1,178 @@
+#include <debug.h>
+#include <memory.h>
+#include <blitter.h>
+#include <interrupt.h>
+#include <c2p.h>
+
+struct C2P {
+  const C2PLayoutT *layout;
+  int words;
+  int cpuWords;
+  short cmds;
+  BlitCmdT *cmd;
+  /* buffers of the part converted by the CPU in split mode */
+  u_short *chunky, *temp, *output[C2P_MAXOUTPUTS];
+  C2PDoneT done;
+  void *data;
+  /* number of parts (blitter & CPU) that have not finished yet */
+  volatile short pending;
+};
+
+/* Passes higher than BLIT_MAXROWS are split into a few blits. */
+static short PassBlits(const C2PPassT *pass, int words) {
+  return (C2PRows(pass, words) + BLIT_MAXROWS - 1) / BLIT_MAXROWS;
+}
+
+C2PT *NewC2P(const C2PLayoutT *layout, int words) {
+  C2PT *c2p = MemAlloc(sizeof(C2PT), MEMF_PUBLIC|MEMF_CLEAR);
+  short i, n = 0;
+
+  Assert((words & 3) == 0);
+
+  for (i = 0; i < layout->passes; i++)
+    n += PassBlits(&layout->pass[i], words);
+
+  c2p->layout = layout;
+  c2p->words = words;
+  c2p->cmd = MemAlloc(sizeof(BlitCmdT) * n, MEMF_PUBLIC|MEMF_CLEAR);
+
+  return c2p;
+}
+
+void DeleteC2P(C2PT *c2p) {
+  if (c2p) {
+    MemFree(c2p->cmd);
+    MemFree(c2p);
+  }
+}
+
+void C2PSetSplit(C2PT *c2p, int cpuWords) {
+  Assert(c2p->layout->local || cpuWords == 0);
+
+  /* Both parts must start at the beginning of 4-word group. */
+  cpuWords &= ~3;
+  c2p->cpuWords = min(cpuWords, c2p->words - 4);
+}
+
+static inline void *ChannelPtr(void **buf, const C2PPassT *pass,
+                               const C2PChannelT *channel, int words)
+{
+  if (channel->buf == C2P_NONE)
+    return NULL;
+  return buf[channel->buf] + C2PChannelOffset(pass, channel, words) * 2;
+}
+
+static BlitCmdT *PassCompile(BlitCmdT *cmd, const C2PPassT *pass, void **buf,
+                             int words)
+{
+  bool srcb = (pass->b.buf != C2P_NONE) ? true : false;
+  void *apt = ChannelPtr(buf, pass, &pass->a, words);
+  void *bpt = ChannelPtr(buf, pass, &pass->b, words);
+  void *dpt = ChannelPtr(buf, pass, &pass->d, words);
+  short width = pass->width;
+  /* bytes per row, negative in descending mode */
+  short astep = (width + pass->a.modulo) * 2;
+  short bstep = (width + pass->b.modulo) * 2;
+  short dstep = (width + pass->d.modulo) * 2;
+  int rows = C2PRows(pass, words);
+
+  if (pass->left)
+    astep = -astep, bstep = -bstep, dstep = -dstep;
+
+  while (rows > 0) {
+    short n = (rows > BLIT_MAXROWS) ? BLIT_MAXROWS : rows;
+
+    cmd->bltcon0 = (SRCA | DEST) | (ABC | ABNC | ANBC | NABNC) |
+                   ASHIFT(pass->ashift);
+    if (srcb)
+      cmd->bltcon0 |= SRCB;
+    cmd->bltcon1 = BSHIFT(pass->bshift) | (pass->left ? BLITREVERSE : 0);
+    cmd->bltafwm = -1;
+    cmd->bltalwm = -1;
+    cmd->bltapt = apt;
+    cmd->bltbpt = bpt;
+    cmd->bltdpt = dpt;
+    cmd->bltamod = pass->a.modulo * 2;
+    cmd->bltbmod = pass->b.modulo * 2;
+    cmd->bltdmod = pass->d.modulo * 2;
+    cmd->bltcdat = pass->mask;
+    cmd->bltbdat = 0;
+    /* height of BLIT_MAXROWS is encoded as 0 */
+    cmd->bltsize = (n << 6) | width;
+
+    apt += n * astep;
+    if (srcb)
+      bpt += n * bstep;
+    dpt += n * dstep;
+    rows -= n;
+    cmd++;
+  }
+
+  return cmd;
+}
+
+void C2PSetBuffers(C2PT *c2p, void *chunky, void *temp, void **output) {
+  const C2PLayoutT *layout = c2p->layout;
+  int words = c2p->words - c2p->cpuWords;
+  void *buf[C2P_OUTPUT(C2P_MAXOUTPUTS)];
+  BlitCmdT *cmd = c2p->cmd;
+  short i;
+
+  buf[C2P_NONE] = NULL;
+  buf[C2P_CHUNKY] = chunky;
+  buf[C2P_TEMP] = temp;
+  for (i = 0; i < layout->outputs; i++)
+    buf[C2P_OUTPUT(i)] = output[i];
+
+  for (i = 0; i < layout->passes; i++)
+    cmd = PassCompile(cmd, &layout->pass[i], buf, words);
+
+  c2p->cmds = cmd - c2p->cmd;
+
+  /* CPU part follows the blitter part in every buffer. */
+  c2p->chunky = chunky + words * 2;
+  c2p->temp = temp + words * 2;
+  for (i = 0; i < layout->outputs; i++)
+    c2p->output[i] = output[i] + words * layout->size / 2;
+}
+
+static void C2PNotify(void *data) {
+  C2PT *c2p = data;
+
+  if (--c2p->pending == 0 && c2p->done)
+    c2p->done(c2p->data);
+}
+
+u_short C2PStart(C2PT *c2p, C2PDoneT done, void *data) {
+  const BlitCmdT *cmd = c2p->cmd;
+  short n = c2p->cmds;
+  u_short fence;
+  bool last;
+
+  /* Callback of previous conversion must not be mixed up with this one. */
+  while (c2p->pending > 0)
+    continue;
+
+  c2p->done = done;
+  c2p->data = data;
+  c2p->pending = c2p->cpuWords ? 2 : 1;
+
+  while (--n > 0)
+    BlitQueueAdd(cmd++);
+  fence = BlitQueueAddNotify(cmd, C2PNotify, c2p);
+
+  if (c2p->cpuWords) {
+    C2PLayoutConvert(c2p->layout, c2p->chunky, c2p->temp, c2p->output,
+                     c2p->cpuWords);
+
+    /* Whichever part finishes last calls back. */
+    DisableINT(INTF_BLIT);
+    last = (--c2p->pending == 0) ? true : false;
+    EnableINT(INTF_BLIT);
+
+    if (last && done)
+      done(data);
+  }
+
+  return fence;
+}
@@ -0,0 +1,68 @@
+#include <c2p.h>
+
+static inline u_short *ChannelStart(u_short **buf, const C2PChannelT *channel,
+                                    int words)
+{
+  if (channel->buf == C2P_NONE)
+    return NULL;
+  return buf[channel->buf] + channel->quarter * (words >> 2) + channel->start;
+}
+
+/*
+ * Does exactly what the blitter would do, but without bothering with
+ * descending mode, since shifted in bits are always masked off anyway.
+ */
+static void PassConvert(const C2PPassT *pass, u_short **buf, int words) {
+  u_short *a = ChannelStart(buf, &pass->a, words);
+  u_short *b = ChannelStart(buf, &pass->b, words);
+  u_short *d = ChannelStart(buf, &pass->d, words);
+  short amod = pass->a.modulo;
+  short bmod = pass->b.modulo;
+  short dmod = pass->d.modulo;
+  short ashift = pass->ashift;
+  short bshift = pass->bshift;
+  u_short mask = pass->mask;
+  int rows = C2PRows(pass, words);
+
+  while (--rows >= 0) {
+    short n = pass->width;
+
+    while (--n >= 0) {
+      u_short x = *a++;
+      u_short y = b ? *b++ : 0;
+
+      if (pass->left) {
+        x <<= ashift;
+        y <<= bshift;
+      } else {
+        x >>= ashift;
+        y >>= bshift;
+      }
+
+      *d++ = (x & mask) | (y & ~mask);
+    }
+
+    a += amod;
+    if (b)
+      b += bmod;
+    d += dmod;
+  }
+}
+
+void C2PLayoutConvert(const C2PLayoutT *layout, u_short *chunky,
+                      u_short *temp, u_short **output, int words)
+{
+  const C2PPassT *pass = layout->pass;
+  u_short *buf[C2P_OUTPUT(C2P_MAXOUTPUTS)];
+  short n = layout->passes;
+  short i;
+
+  buf[C2P_NONE] = NULL;
+  buf[C2P_CHUNKY] = chunky;
+  buf[C2P_TEMP] = temp;
+  for (i = 0; i < layout->outputs; i++)
+    buf[C2P_OUTPUT(i)] = output[i];
+
+  while (--n >= 0)
+    PassConvert(pass++, buf, words);
+}
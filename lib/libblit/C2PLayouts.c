@@ -0,0 +1,169 @@
+#include <c2p.h>
+
+/*
+ * Passes transcribed from scripts in prototypes/c2p. Keep both in sync, the
+ * scripts show what happens to each bit on the way. Prototypes number pixel
+ * bits starting from the most significant one, here planes are numbered as
+ * usual, i.e. plane 0 holds the least significant bit.
+ */
+
+#define CH(buf, start, modulo) { buf, 0, start, modulo }
+#define CHQ(buf, quarter, start, modulo) { buf, quarter, start, modulo }
+
+#define RIGHT false
+#define LEFT true
+
+static const C2PPassT Passes1x1x4[] = {
+  /* Swap 8x4 */
+  { CH(C2P_CHUNKY, 2, 2), CH(C2P_CHUNKY, 0, 2), CH(C2P_TEMP, 0, 2),
+    0x00ff, 8, 0, RIGHT, 2, 4 },
+  { CH(C2P_CHUNKY, 0, 2), CH(C2P_CHUNKY, 2, 2), CH(C2P_TEMP, 2, 2),
+    0xff00, 8, 0, LEFT, 2, 4 },
+  /* Swap 4x2 */
+  { CH(C2P_TEMP, 1, 1), CH(C2P_TEMP, 0, 1), CH(C2P_CHUNKY, 0, 1),
+    0x0f0f, 4, 0, RIGHT, 1, 2 },
+  { CH(C2P_TEMP, 0, 1), CH(C2P_TEMP, 1, 1), CH(C2P_CHUNKY, 1, 1),
+    0xf0f0, 4, 0, LEFT, 1, 2 },
+  /* Swap 2x2 */
+  { CH(C2P_CHUNKY, 2, 2), CH(C2P_CHUNKY, 0, 2), CH(C2P_TEMP, 0, 2),
+    0x3333, 2, 0, RIGHT, 2, 4 },
+  { CH(C2P_CHUNKY, 0, 2), CH(C2P_CHUNKY, 2, 2), CH(C2P_TEMP, 2, 2),
+    0xcccc, 2, 0, LEFT, 2, 4 },
+  /* Swap 1x1 into bitplanes */
+  { CH(C2P_TEMP, 1, 3), CH(C2P_TEMP, 0, 3), CH(C2P_OUTPUT(3), 0, 0),
+    0x5555, 1, 0, RIGHT, 1, 4 },
+  { CH(C2P_TEMP, 3, 3), CH(C2P_TEMP, 2, 3), CH(C2P_OUTPUT(1), 0, 0),
+    0x5555, 1, 0, RIGHT, 1, 4 },
+  { CH(C2P_TEMP, 0, 3), CH(C2P_TEMP, 1, 3), CH(C2P_OUTPUT(2), 0, 0),
+    0xaaaa, 1, 0, LEFT, 1, 4 },
+  { CH(C2P_TEMP, 2, 3), CH(C2P_TEMP, 3, 3), CH(C2P_OUTPUT(0), 0, 0),
+    0xaaaa, 1, 0, LEFT, 1, 4 },
+};
+
+const C2PLayoutT C2PLayout1x1x4 = {
+  "1x1x4",
+  "4 pixels per word, first one in the most significant nibble",
+  sizeof(Passes1x1x4) / sizeof(C2PPassT), 4, 1, true, Passes1x1x4
+};
+
+static const C2PPassT Passes1x1x4Mangled[] = {
+  /* Swap 8x4 */
+  { CH(C2P_CHUNKY, 0, 2), CH(C2P_CHUNKY, 2, 2), CH(C2P_TEMP, 0, 2),
+    0xff00, 0, 8, RIGHT, 2, 4 },
+  { CH(C2P_CHUNKY, 0, 2), CH(C2P_CHUNKY, 2, 2), CH(C2P_TEMP, 2, 2),
+    0xff00, 8, 0, LEFT, 2, 4 },
+  /* Swap 4x2 */
+  { CH(C2P_TEMP, 0, 1), CH(C2P_TEMP, 1, 1), CH(C2P_CHUNKY, 0, 1),
+    0xf0f0, 0, 4, RIGHT, 1, 2 },
+  { CH(C2P_TEMP, 0, 1), CH(C2P_TEMP, 1, 1), CH(C2P_CHUNKY, 1, 1),
+    0xf0f0, 4, 0, LEFT, 1, 2 },
+  /* Swap 2x2 into bitplanes */
+  { CH(C2P_CHUNKY, 0, 3), CH(C2P_CHUNKY, 2, 3), CH(C2P_OUTPUT(3), 0, 0),
+    0xcccc, 0, 2, RIGHT, 1, 4 },
+  { CH(C2P_CHUNKY, 1, 3), CH(C2P_CHUNKY, 3, 3), CH(C2P_OUTPUT(2), 0, 0),
+    0xcccc, 0, 2, RIGHT, 1, 4 },
+  { CH(C2P_CHUNKY, 0, 3), CH(C2P_CHUNKY, 2, 3), CH(C2P_OUTPUT(1), 0, 0),
+    0xcccc, 2, 0, LEFT, 1, 4 },
+  { CH(C2P_CHUNKY, 1, 3), CH(C2P_CHUNKY, 3, 3), CH(C2P_OUTPUT(0), 0, 0),
+    0xcccc, 2, 0, LEFT, 1, 4 },
+};
+
+const C2PLayoutT C2PLayout1x1x4Mangled = {
+  "1x1x4-mangled",
+  "4 pixels per word, bits of pixels a, b and c, d interleaved: "
+  "[a3 b3 a1 b1 a2 b2 a0 b0 c3 d3 c1 d1 c2 d2 c0 d0]",
+  sizeof(Passes1x1x4Mangled) / sizeof(C2PPassT), 4, 1, true,
+  Passes1x1x4Mangled
+};
+
+static const C2PPassT Passes1x1Ham6Mangled[] = {
+  /* Swap 8x4 */
+  { CH(C2P_CHUNKY, 2, 2), CH(C2P_CHUNKY, 0, 2), CH(C2P_TEMP, 0, 2),
+    0x00ff, 8, 0, RIGHT, 2, 4 },
+  { CH(C2P_CHUNKY, 0, 2), CH(C2P_CHUNKY, 2, 2), CH(C2P_TEMP, 2, 2),
+    0xff00, 8, 0, LEFT, 2, 4 },
+  /* Swap 4x4 into bitplanes */
+  { CH(C2P_TEMP, 1, 3), CH(C2P_TEMP, 0, 3), CH(C2P_OUTPUT(3), 0, 0),
+    0x0f0f, 4, 0, RIGHT, 1, 4 },
+  { CH(C2P_TEMP, 3, 3), CH(C2P_TEMP, 2, 3), CH(C2P_OUTPUT(1), 0, 0),
+    0x0f0f, 4, 0, RIGHT, 1, 4 },
+  { CH(C2P_TEMP, 0, 3), CH(C2P_TEMP, 1, 3), CH(C2P_OUTPUT(2), 0, 0),
+    0xf0f0, 4, 0, LEFT, 1, 4 },
+  { CH(C2P_TEMP, 2, 3), CH(C2P_TEMP, 3, 3), CH(C2P_OUTPUT(0), 0, 0),
+    0xf0f0, 4, 0, LEFT, 1, 4 },
+};
+
+const C2PLayoutT C2PLayout1x1Ham6Mangled = {
+  "1x1-ham6-mangled",
+  "one 12-bit pixel per word, shown as four HAM pixels (red, green, blue, "
+  "blue): [r3 g3 b3 b3 r2 g2 b2 b2 r1 g1 b1 b1 r0 g0 b0 b0], HAM control "
+  "bits in planes 4 and 5 are left to the caller",
+  sizeof(Passes1x1Ham6Mangled) / sizeof(C2PPassT), 4, 1, true,
+  Passes1x1Ham6Mangled
+};
+
+static const C2PPassT Passes2x1x4Mangled[] = {
+  /* Swap 8x2 */
+  { CH(C2P_CHUNKY, 1, 1), CH(C2P_CHUNKY, 0, 1), CH(C2P_TEMP, 0, 1),
+    0x00ff, 8, 0, RIGHT, 1, 2 },
+  { CH(C2P_CHUNKY, 0, 1), CH(C2P_CHUNKY, 1, 1), CH(C2P_TEMP, 1, 1),
+    0xff00, 8, 0, LEFT, 1, 2 },
+  /* Swap 4x2 */
+  { CH(C2P_TEMP, 0, 1), CH(C2P_TEMP, 1, 1), CH(C2P_CHUNKY, 0, 1),
+    0xf0f0, 0, 4, RIGHT, 1, 2 },
+  { CH(C2P_TEMP, 0, 1), CH(C2P_TEMP, 1, 1), CH(C2P_CHUNKY, 1, 1),
+    0xf0f0, 4, 0, LEFT, 1, 2 },
+  /* Expand 2x1 into bitplanes */
+  { CH(C2P_CHUNKY, 0, 1), CH(C2P_CHUNKY, 0, 1), CH(C2P_OUTPUT(3), 0, 0),
+    0x5555, 1, 0, RIGHT, 1, 2 },
+  { CH(C2P_CHUNKY, 1, 1), CH(C2P_CHUNKY, 1, 1), CH(C2P_OUTPUT(1), 0, 0),
+    0x5555, 1, 0, RIGHT, 1, 2 },
+  { CH(C2P_CHUNKY, 0, 1), CH(C2P_CHUNKY, 0, 1), CH(C2P_OUTPUT(2), 0, 0),
+    0xaaaa, 1, 0, LEFT, 1, 2 },
+  { CH(C2P_CHUNKY, 1, 1), CH(C2P_CHUNKY, 1, 1), CH(C2P_OUTPUT(0), 0, 0),
+    0xaaaa, 1, 0, LEFT, 1, 2 },
+};
+
+const C2PLayoutT C2PLayout2x1x4Mangled = {
+  "2x1x4-mangled",
+  "4 pixels per word, bits of pixels a, b and c, d interleaved: "
+  "[a3 a2 b3 b2 a1 a0 b1 b0 c3 c2 d3 d2 c1 c0 d1 d0]",
+  sizeof(Passes2x1x4Mangled) / sizeof(C2PPassT), 4, 2, true,
+  Passes2x1x4Mangled
+};
+
+/*
+ * Used by uvmap. Halves of intermediate and output buffers hold separate
+ * arrays of prototype, so expansion takes two blits instead of four. First
+ * output buffer holds plane 0 followed by plane 2, second one plane 1 followed
+ * by plane 3.
+ */
+static const C2PPassT Passes2x1x4MangledFast[] = {
+  /* Swap 4x2 */
+  { CH(C2P_CHUNKY, 0, 1), CH(C2P_CHUNKY, 1, 1), CHQ(C2P_TEMP, 2, 0, 0),
+    0xf0f0, 0, 4, RIGHT, 1, 2 },
+  { CH(C2P_CHUNKY, 0, 1), CH(C2P_CHUNKY, 1, 1), CH(C2P_TEMP, 0, 0),
+    0xf0f0, 4, 0, LEFT, 1, 2 },
+  /* Expand 2x1 into bitplanes */
+  { CH(C2P_TEMP, 0, 0), CH(C2P_TEMP, 0, 0), CH(C2P_OUTPUT(1), 0, 0),
+    0xaaaa, 0, 1, RIGHT, 4, 4 },
+  { CH(C2P_TEMP, 0, 0), CH(C2P_TEMP, 0, 0), CH(C2P_OUTPUT(0), 0, 0),
+    0xaaaa, 1, 0, LEFT, 4, 4 },
+};
+
+const C2PLayoutT C2PLayout2x1x4MangledFast = {
+  "2x1x4-mangled-fast",
+  "as 2x1x4-mangled, but with second and third byte of each long word "
+  "swapped",
+  sizeof(Passes2x1x4MangledFast) / sizeof(C2PPassT), 2, 4, false,
+  Passes2x1x4MangledFast
+};
+
+const C2PLayoutT *C2PLayouts[] = {
+  &C2PLayout1x1x4,
+  &C2PLayout1x1x4Mangled,
+  &C2PLayout1x1Ham6Mangled,
+  &C2PLayout2x1x4Mangled,
+  &C2PLayout2x1x4MangledFast,
+  NULL
+};
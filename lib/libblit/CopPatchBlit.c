@@ -0,0 +1,32 @@
+#include <debug.h>
+#include <string.h>
+#include <blitter.h>
+
+/* One command per list, so both lists can be patched in the same frame. */
+static BlitCmdT state[2];
+
+/*
+ * Copies all values into data words of MOVE instructions of list 'n'. Each
+ * value is a row one word wide, destination modulo skips the rest of stride.
+ * Values must not change till the blit is done.
+ */
+const BlitCmdT *CopPatchCmd(const CopPatchT *patch, short n) {
+  BlitCmdT *cmd = &state[n];
+
+  Assert(patch->stride > 0);
+  Assert(patch->count <= BLIT_MAXROWS);
+
+  memcpy(patch->shadow[n], patch->value, sizeof(short) * patch->count);
+
+  cmd->bltcon0 = (SRCA | DEST) | A_TO_D;
+  cmd->bltcon1 = 0;
+  cmd->bltafwm = -1;
+  cmd->bltalwm = -1;
+  cmd->bltapt = patch->value;
+  cmd->bltdpt = &patch->ins[n][0]->move.data;
+  cmd->bltamod = 0;
+  cmd->bltdmod = patch->stride * sizeof(CopInsT) - sizeof(short);
+  /* height of BLIT_MAXROWS is encoded as 0 */
+  cmd->bltsize = (patch->count << 6) | 1;
+  return cmd;
+}
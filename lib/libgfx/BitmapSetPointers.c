@@ -5,9 +5,13 @@ void BitmapSetPointers(BitmapT *bitmap, void *planes) {
     (bitmap->flags & BM_INTERLEAVED) ? bitmap->bytesPerRow : bitmap->bplSize;
   short depth = bitmap->depth;
   void **planePtr = bitmap->planes;
+  void *scratch = planes + (u_int)bitmap->bplSize * depth;
 
-  do {
+  while (--depth >= 0) {
     *planePtr++ = planes;
     planes += modulo;
-  } while (depth--);
+  }
+
+  /* Scratchpad area follows last bitplane, also in interleaved bitmaps. */
+  *planePtr = scratch;
 }
@@ -3,5 +3,5 @@
 u_int BitmapSize(BitmapT *bitmap) {
   /* Allocate extra two bytes for scratchpad area.
    * Used by blitter line drawing. */
-  return ((u_short)bitmap->bplSize * (u_short)bitmap->depth) + BM_EXTRA;
+  return (u_int)bitmap->bplSize * bitmap->depth + BM_EXTRA;
 }
@@ -1,7 +1,7 @@
 #include <circle.h>
 
 void Circle(const BitmapT *bitmap, int plane, short xc, short yc, short r) {
-  int stride = bitmap->bytesPerRow;
+  int stride = BitmapStride(bitmap);
 
   u_char *pixels = bitmap->planes[plane] + yc * (short)stride;
   u_char *q0 = pixels;
@@ -0,0 +1,61 @@
+#include <debug.h>
+#include <copper.h>
+#include <memory.h>
+
+CopPatchT *NewCopPatch(short count, u_int memFlags) {
+  CopPatchT *patch = MemAlloc(sizeof(CopPatchT), MEMF_PUBLIC|MEMF_CLEAR);
+
+  patch->count = count;
+  patch->value = MemAlloc(sizeof(short) * count, memFlags|MEMF_CLEAR);
+  patch->shadow[0] = MemAlloc(sizeof(short) * count, MEMF_PUBLIC);
+  patch->shadow[1] = MemAlloc(sizeof(short) * count, MEMF_PUBLIC);
+  patch->ins[0] = MemAlloc(sizeof(CopInsT *) * count, MEMF_PUBLIC|MEMF_CLEAR);
+  patch->ins[1] = MemAlloc(sizeof(CopInsT *) * count, MEMF_PUBLIC|MEMF_CLEAR);
+
+  return patch;
+}
+
+void DeleteCopPatch(CopPatchT *patch) {
+  if (patch) {
+    MemFree(patch->ins[1]);
+    MemFree(patch->ins[0]);
+    MemFree(patch->shadow[1]);
+    MemFree(patch->shadow[0]);
+    MemFree(patch->value);
+    MemFree(patch);
+  }
+}
+
+void CopPatchBind(CopPatchT *patch, short n, short i, CopInsT *ins) {
+  CopInsT **slot = patch->ins[n];
+
+  Assert(i >= 0 && i < patch->count);
+
+  slot[i] = ins;
+  patch->shadow[n][i] = ins->move.data;
+
+  /* Stride is known after second MOVE of first list has been bound. */
+  if (n == 0 && i == 1)
+    patch->stride = ins - slot[0];
+  else if (i > 0 && ins != slot[i - 1] + patch->stride)
+    patch->stride = 0;
+}
+
+void CopPatchUpdate(CopPatchT *patch, short n) {
+  CopInsT **ins = patch->ins[n];
+  short *shadow = patch->shadow[n];
+  short *value = patch->value;
+  short count = patch->count;
+
+  while (--count >= 0) {
+    short data = *value++;
+
+    if (*shadow != data) {
+      *shadow = data;
+      (*ins)->move.data = data;
+    }
+
+    shadow++;
+    ins++;
+  }
+}
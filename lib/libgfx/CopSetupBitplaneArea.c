@@ -15,13 +15,13 @@ void CopSetupBitplaneArea(CopListT *list, u_short mode, u_short depth,
     /* Seems that bitplane fetcher has to be active for at least two words! */
     if (w < 32)
       w = 32;
-    start = bitmap->bytesPerRow * area->y + ((area->x >> 3) & ~1);
-    modulo = bitmap->bytesPerRow - ((w >> 3) & ~1);
+    start = BitmapStride(bitmap) * area->y + ((area->x >> 3) & ~1);
+    modulo = BitmapStride(bitmap) - ((w >> 3) & ~1);
     x -= (area->x & 15);
   } else {
     w = (bitmap->width + 15) & ~15;
     start = 0;
-    modulo = 0;
+    modulo = BitmapStride(bitmap) - bitmap->bytesPerRow;
   }
 
   for (i = 0; i < depth; i++)
@@ -7,7 +7,7 @@ static struct {
 
 void CpuLineSetup(const BitmapT *bitmap, u_short plane) {
   line.pixels = bitmap->planes[plane];
-  line.stride = bitmap->bytesPerRow;
+  line.stride = BitmapStride(bitmap);
 }
 
 void CpuLine(short xs asm("d0"), short ys asm("d1"),
@@ -0,0 +1,186 @@
+#include <debug.h>
+#include <memory.h>
+#include <sort.h>
+#include <sprite.h>
+
+#define CHANNELS 8
+
+struct SpriteMux {
+  short maxSprites;
+  short capacity; /* long words of sprite data per channel */
+  short active;
+  u_int *buffer[2];
+  SortItemT *item, *temp;
+};
+
+typedef struct {
+  u_int *data;    /* where control words of next sprite go */
+  u_int *limit;   /* last long word, reserved for terminator */
+  short vstart;   /* first line at which next sprite can start */
+} ChannelT;
+
+SpriteMuxT *NewSpriteMux(short maxSprites, short lines) {
+  SpriteMuxT *mux = MemAlloc(sizeof(SpriteMuxT), MEMF_PUBLIC|MEMF_CLEAR);
+  /* Each sprite takes at least one line and must be followed by a gap. */
+  short capacity = lines + (lines + 1) / 2 + 1;
+  int size = SprDataSize(lines, (lines + 1) / 2 + 1) * CHANNELS;
+
+  mux->maxSprites = maxSprites;
+  mux->capacity = capacity;
+  mux->buffer[0] = MemAlloc(size, MEMF_CHIP|MEMF_CLEAR);
+  mux->buffer[1] = MemAlloc(size, MEMF_CHIP|MEMF_CLEAR);
+  mux->item = MemAlloc(sizeof(SortItemT) * maxSprites, MEMF_PUBLIC);
+  mux->temp = MemAlloc(sizeof(SortItemT) * maxSprites, MEMF_PUBLIC);
+
+  return mux;
+}
+
+void DeleteSpriteMux(SpriteMuxT *mux) {
+  if (mux) {
+    MemFree(mux->temp);
+    MemFree(mux->item);
+    MemFree(mux->buffer[1]);
+    MemFree(mux->buffer[0]);
+    MemFree(mux);
+  }
+}
+
+static inline bool ChannelFits(ChannelT *ch, short y, short height) {
+  return (ch->vstart <= y && ch->data + height + 1 <= ch->limit) ? true : false;
+}
+
+/*
+ * Prefer channels whose pair is taken, so that pairs stay available for
+ * attached sprites. Otherwise take the channel that got free most recently,
+ * as earlier ones may fit sprites that start higher.
+ */
+static short SingleChannel(ChannelT *channel, short y, short height) {
+  short best = -1;
+  bool bestTaken = false;
+  short i;
+
+  for (i = 0; i < CHANNELS; i++) {
+    bool taken;
+
+    if (!ChannelFits(&channel[i], y, height))
+      continue;
+
+    taken = ChannelFits(&channel[i ^ 1], y, height) ? false : true;
+
+    if (best < 0 || (taken && !bestTaken) ||
+        (taken == bestTaken && channel[i].vstart > channel[best].vstart))
+    {
+      best = i;
+      bestTaken = taken;
+    }
+  }
+
+  return best;
+}
+
+static short PairChannel(ChannelT *channel, short y, short height) {
+  short best = -1;
+  short bestStart = 0;
+  short i;
+
+  for (i = 0; i < CHANNELS; i += 2) {
+    short start = max(channel[i].vstart, channel[i + 1].vstart);
+
+    if (!ChannelFits(&channel[i], y, height) ||
+        !ChannelFits(&channel[i + 1], y, height))
+      continue;
+
+    if (best < 0 || start > bestStart) {
+      best = i;
+      bestStart = start;
+    }
+  }
+
+  return best;
+}
+
+static void ChannelAdd(ChannelT *ch, SpriteT *spr, short x, short y,
+                       bool attached)
+{
+  u_int *src = (u_int *)spr->sprdat->data;
+  u_int *dst = ch->data;
+  short height = spr->height;
+  u_short vstop = y + height;
+  u_short pos = (y << 8) | ((x >> 1) & 255);
+  u_short ctl = (vstop << 8) | (x & 1) | (attached ? 0x80 : 0);
+  short n = height - 1;
+
+  /* Same encoding as in SpriteUpdatePos. */
+  if (y & 0x100)
+    ctl |= 4;
+  if (vstop & 0x100)
+    ctl |= 2;
+
+  *dst++ = ((u_int)pos << 16) | ctl;
+
+  do {
+    *dst++ = *src++;
+  } while (--n != -1);
+
+  ch->data = dst;
+  ch->vstart = vstop + 1;
+}
+
+short SpriteMuxBuild(SpriteMuxT *mux, MuxSpriteT *sprite, short count,
+                     CopInsT **sprptr)
+{
+  u_int *buffer = mux->buffer[mux->active];
+  ChannelT channel[CHANNELS];
+  SortItemT *item = mux->item;
+  short dropped = 0;
+  short i, n;
+
+  Assert(count <= mux->maxSprites);
+
+  for (i = 0; i < CHANNELS; i++) {
+    channel[i].data = buffer + i * mux->capacity;
+    channel[i].limit = channel[i].data + mux->capacity - 1;
+    channel[i].vstart = 0;
+  }
+
+  for (i = 0; i < count; i++) {
+    item[i].key = sprite[i].y;
+    item[i].index = i;
+  }
+
+  RadixSortItemArray(item, mux->temp, count);
+
+  for (n = count - 1; n >= 0; n--, item++) {
+    MuxSpriteT *mspr = &sprite[item->index];
+    SpriteT *spr0 = mspr->sprite[0];
+    SpriteT *spr1 = mspr->sprite[1];
+    short height = spr0->height;
+    short x = mspr->x;
+    short y = mspr->y;
+
+    if (spr1) {
+      Assert(spr1->height == height);
+      if ((i = PairChannel(channel, y, height)) < 0) {
+        dropped++;
+        continue;
+      }
+      ChannelAdd(&channel[i], spr0, x, y, false);
+      ChannelAdd(&channel[i + 1], spr1, x, y, true);
+    } else {
+      if ((i = SingleChannel(channel, y, height)) < 0) {
+        dropped++;
+        continue;
+      }
+      ChannelAdd(&channel[i], spr0, x, y, false);
+    }
+  }
+
+  for (i = 0; i < CHANNELS; i++) {
+    *channel[i].data = 0;
+    CopInsSet32(*sprptr++, buffer + i * mux->capacity);
+  }
+
+  mux->active ^= 1;
+
+  return dropped;
+}
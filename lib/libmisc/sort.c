@@ -1,3 +1,5 @@
+#include <string.h>
+#include <strings.h>
 #include "sort.h"
 
 static void InsertSort(SortItemT *first, SortItemT *last) {
@@ -45,6 +47,83 @@ static void QuickSort(SortItemT *first, SortItemT *last) {
   }
 }
 
+/* QuickSort swaps pivot with second item unchecked if there are only two. */
 void SortItemArray(SortItemT *table, short size) {
-  QuickSort(table, &table[size - 1]);
+  SortItemT *last = &table[size - 1];
+
+  if ((void *)last - (void *)table > THRESHOLD)
+    QuickSort(table, last);
+  else
+    InsertSort(table, last);
+}
+
+/*
+ * Least significant digit radix sort with two passes over bytes of the key.
+ * Both passes are stable, so items with equal keys keep their order. If all
+ * keys fit within 256 consecutive values a single pass is enough.
+ */
+
+#define RADIX_THRESHOLD 32
+
+static short count[2][256];
+static SortItemT *bucket[256];
+
+static void Scatter(SortItemT *src, SortItemT *dst, short *cnt,
+                    short first, short buckets, short size, short shift)
+{
+  short n = buckets - 1;
+
+  /* Turn item counts into pointers to beginning of buckets. */
+  do {
+    first &= 255;
+    bucket[first] = dst;
+    dst += cnt[first++];
+  } while (--n != -1);
+
+  n = size - 1;
+  do {
+    u_short key = src->key ^ 0x8000;
+    *bucket[(u_char)(key >> shift)]++ = *src++;
+  } while (--n != -1);
+}
+
+void RadixSortItemArray(SortItemT *table, SortItemT *temp, short size) {
+  short min = 0x7fff;
+  short max = -0x8000;
+
+  if (size < RADIX_THRESHOLD) {
+    if (size > 1)
+      InsertSort(table, &table[size - 1]);
+    return;
+  }
+
+  bzero(count, sizeof(count));
+
+  {
+    short *lo = count[0];
+    short *hi = count[1];
+    SortItemT *item = table;
+    short n = size - 1;
+
+    do {
+      short key = (item++)->key;
+      if (key < min)
+        min = key;
+      if (key > max)
+        max = key;
+      lo[(u_char)key]++;
+      /* Flip sign bit so that negative keys go before positive ones. */
+      hi[(u_char)((u_short)(key ^ 0x8000) >> 8)]++;
+    } while (--n != -1);
+  }
+
+  if ((int)max - (int)min < 256) {
+    Scatter(table, temp, count[0], (u_char)min, max - min + 1, size, 0);
+    memcpy(table, temp, size * sizeof(SortItemT));
+  } else {
+    short hiMin = (u_short)(min ^ 0x8000) >> 8;
+    short hiMax = (u_short)(max ^ 0x8000) >> 8;
+    Scatter(table, temp, count[0], 0, 256, size, 0);
+    Scatter(temp, table, count[1], hiMin, hiMax - hiMin + 1, size, 8);
+  }
 }
@@ -27,6 +27,9 @@ static FileEntryT *NextFileEntry(FileEntryT *fe) {
 
 /* Finished by NUL character (reclen = 0). */
 static FileEntryT *rootDir = NULL;
+/* Entries are sorted by name on disk, so they can be binary searched. */
+static FileEntryT **rootIndex = NULL;
+static short rootEntries = 0;
 
 struct File {
   FileOpsT *ops;
@@ -96,22 +99,37 @@ static FileT *NewFile(int length, int offset) {
 }
 
 static FileEntryT *LookupFile(const char *path) {
-  FileEntryT *fe = rootDir;
+  short lo = 0;
+  short hi = rootEntries - 1;
 
-  if (fe == NULL)
-    return NULL;
+  while (lo <= hi) {
+    short mid = (lo + hi) >> 1;
+    FileEntryT *fe = rootIndex[mid];
+    int cmp = strcmp(path, fe->name);
 
-  do {
-    if (strcmp(path, fe->name) == 0)
+    if (cmp == 0)
       return fe;
-    fe = NextFileEntry(fe);
-  } while (fe->reclen);
+    if (cmp < 0)
+      hi = mid - 1;
+    else
+      lo = mid + 1;
+  }
 
   return NULL;
 }
 
 FileT *OpenFile(const char *path) {
   FileEntryT *entry;
+  /* fsutil.py can lay out files using load order recorded from this line. */
+  Log("[FileSys] Open '%s'.\n", path);
+#ifdef REMOTEFS
+  /* Files that host does not serve are taken from the floppy. */
+  {
+    FileT *f;
+    if ((f = RemoteOpen(path)))
+      return f;
+  }
+#endif
   if ((entry = LookupFile(path)))
     return NewFile(entry->size, entry->start * TD_SECTOR);
   return NULL;
@@ -194,6 +212,13 @@ static int FsSeek(FileT *file, int offset, int whence) {
 
 int GetFileSize(const char *path) {
   FileEntryT *entry;
+#ifdef REMOTEFS
+  {
+    int size;
+    if ((size = RemoteFileSize(path)) >= 0)
+      return size;
+  }
+#endif
   if ((entry = LookupFile(path)))
     return entry->size;
   return ENOENT;
@@ -233,11 +258,31 @@ void InitFileSys(void) {
       Log("[FileSys] Sector %d: %s file '%s' of %d bytes.\n",
           fe->start, fe->type ? "executable" : "regular", fe->name, fe->size);
       fe = NextFileEntry(fe);
+      rootEntries++;
     } while (fe->reclen);
   }
+
+  /* build index for name lookup */
+  {
+    FileEntryT *fe = rootDir;
+    short i;
+
+    rootIndex = MemAlloc(rootEntries * sizeof(FileEntryT *), MEMF_PUBLIC);
+
+    for (i = 0; i < rootEntries; i++) {
+      rootIndex[i] = fe;
+      fe = NextFileEntry(fe);
+      Assert(i == 0 || strcmp(rootIndex[i - 1]->name, rootIndex[i]->name) < 0);
+    }
+  }
 }
 
 void KillFileSys(void) {
+  if (rootIndex) {
+    MemFree(rootIndex);
+    rootIndex = NULL;
+    rootEntries = 0;
+  }
   if (rootDir) {
     MemFree(rootDir);
     rootDir = NULL;
@@ -167,7 +167,11 @@ void FloppyTrackRead(short num) {
     ChangeDiskSide(num & 1);
 
   if (num != trackNum) {
-    HeadsStepDirection(num > trackNum);
+    short inwards = num > trackNum;
+
+    /* Heads have to settle only if stepping direction changes. */
+    if (inwards != (headDir > 0))
+      HeadsStepDirection(inwards);
     while (num != trackNum)
       StepHeads();
   }
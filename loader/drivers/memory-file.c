@@ -21,7 +21,7 @@ static FileOpsT MemOps = {
   .close = MemClose
 };
 
-FileT *MemOpen(const void *buf, u_int length) {
+FileT *MemoryOpen(const void *buf, u_int length) {
   FileT *f = MemAlloc(sizeof(FileT), MEMF_PUBLIC);
   f->ops = &MemOps;
   f->buf = buf;
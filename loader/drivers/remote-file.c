@@ -0,0 +1,188 @@
+#include <string.h>
+#include <common.h>
+#include <debug.h>
+#include <memory.h>
+#include <filesys.h>
+#include <errno.h>
+
+/*
+ * Files are served by tools/remotefs.py connected to serial port.
+ *
+ * Request (all values are big endian):
+ *  [BYTE] 'F'
+ *  [BYTE] command : 'O' (open), 'R' (read) or 'C' (close)
+ *  [WORD] length  : size of the payload or number of bytes to read
+ *  [LONG] handle  : file handle returned by open
+ *  [LONG] offset  : read position
+ *  [...]  payload : path name for open (NUL terminated)
+ *
+ * Reply:
+ *  [LONG] result  : negative error code, handle for open, size for read
+ *  [LONG] size    : file size (open only)
+ *  [...]  data    : file contents (read only)
+ *  [WORD] checksum: of data (read only)
+ */
+
+#define REMOTE_BAUD 115200
+#define REMOTE_CHUNK 1024
+#define REMOTE_RETRY 3
+
+typedef struct {
+  u_char magic;
+  u_char cmd;
+  u_short length;
+  int handle;
+  u_int offset;
+} RequestT;
+
+struct File {
+  FileOpsT *ops;
+  int handle;
+  u_int length;
+  u_int pos;
+};
+
+static int RemoteRead(FileT *f, void *buf, u_int nbyte);
+static int RemoteSeek(FileT *f, int offset, int whence);
+static void RemoteClose(FileT *f);
+
+static FileOpsT RemoteOps = {
+  .read = RemoteRead,
+  .write = NULL,
+  .seek = RemoteSeek,
+  .close = RemoteClose
+};
+
+static FileT *Serial(void) {
+  return SerialOpen(REMOTE_BAUD, O_BINARY);
+}
+
+static void Request(u_char cmd, int handle, u_int offset,
+                    const void *payload, u_short length)
+{
+  RequestT req = { 'F', cmd, length, handle, offset };
+  FileWrite(Serial(), &req, sizeof(req));
+  if (payload)
+    FileWrite(Serial(), payload, length);
+}
+
+static void Receive(void *buf, int nbyte) {
+  while (nbyte > 0) {
+    int n = FileRead(Serial(), buf, nbyte);
+    buf += n; nbyte -= n;
+  }
+}
+
+static int ReceiveLong(void) {
+  int v;
+  Receive(&v, sizeof(v));
+  return v;
+}
+
+/* Fletcher-16 with modulo 256 is cheap to compute on 68000. */
+static u_short Checksum(const u_char *data, int n) {
+  u_char a = 0, b = 0;
+  while (--n >= 0) {
+    a += *data++;
+    b += a;
+  }
+  return (b << 8) | a;
+}
+
+static int RemoteOpenFile(const char *path, u_int *length) {
+  int handle;
+
+  Request('O', 0, 0, path, strlen(path) + 1);
+  if ((handle = ReceiveLong()) >= 0)
+    *length = ReceiveLong();
+  return handle;
+}
+
+FileT *RemoteOpen(const char *path) {
+  FileT *f;
+  u_int length;
+  int handle;
+
+  if ((handle = RemoteOpenFile(path, &length)) < 0) {
+    Log("[RemoteFS] Failed to open '%s'!\n", path);
+    return NULL;
+  }
+
+  f = MemAlloc(sizeof(FileT), MEMF_PUBLIC);
+  f->ops = &RemoteOps;
+  f->handle = handle;
+  f->length = length;
+  f->pos = 0;
+  return f;
+}
+
+int RemoteFileSize(const char *path) {
+  u_int length;
+  int handle;
+
+  if ((handle = RemoteOpenFile(path, &length)) < 0)
+    return ENOENT;
+  Request('C', handle, 0, NULL, 0);
+  (void)ReceiveLong();
+  return length;
+}
+
+static void RemoteClose(FileT *f) {
+  Request('C', f->handle, 0, NULL, 0);
+  (void)ReceiveLong();
+  MemFree(f);
+}
+
+static int ReadChunk(FileT *f, void *buf, u_short nbyte) {
+  short retry = REMOTE_RETRY;
+
+  do {
+    u_short sum;
+    int n;
+
+    Request('R', f->handle, f->pos, NULL, nbyte);
+    if ((n = ReceiveLong()) < 0)
+      return n;
+    Receive(buf, n);
+    Receive(&sum, sizeof(sum));
+
+    if (sum == Checksum(buf, n))
+      return n;
+
+    Log("[RemoteFS] Checksum mismatch at %d, retrying!\n", f->pos);
+  } while (--retry >= 0);
+
+  return EIO;
+}
+
+static int RemoteRead(FileT *f, void *buf, u_int nbyte) {
+  u_int size = min(nbyte, f->length - f->pos);
+  u_int left = size;
+
+  while (left > 0) {
+    int n = ReadChunk(f, buf, min(left, (u_int)REMOTE_CHUNK));
+    if (n < 0)
+      return n;
+    if (n == 0)
+      break;
+    f->pos += n; buf += n; left -= n;
+  }
+
+  return size - left;
+}
+
+static int RemoteSeek(FileT *f, int offset, int whence) {
+  if (whence == SEEK_CUR) {
+    offset += f->pos;
+  } else if (whence == SEEK_END) {
+    offset += f->length;
+  } else if (whence != SEEK_SET) {
+    return EINVAL;
+  }
+
+  if ((offset < 0) || (offset > (int)f->length))
+    return EINVAL;
+
+  f->pos = offset;
+  return offset;
+}
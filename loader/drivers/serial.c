@@ -8,7 +8,8 @@
 #include <memory.h>
 
 #define CLOCK 3546895
-#define QUEUELEN 80
+/* Must be a power of two. */
+#define QUEUELEN 256
 
 typedef struct {
   u_short head, tail;
@@ -145,7 +146,7 @@ static int SerialWrite(FileT *f, const void *_buf, u_int nbyte) {
   for (i = 0; i < nbyte; i++) {
     u_char data = *buf++;
     PushChar(f->sendq, data, f->flags);
-    if (data == '\n')
+    if (data == '\n' && !(f->flags & O_BINARY))
       PushChar(f->sendq, '\r', f->flags);
   }
 
@@ -158,7 +159,7 @@ static int SerialRead(FileT *f, void *_buf, u_int nbyte) {
 
   while (i < nbyte) {
     buf[i] = PopChar(f->recvq, f->flags);
-    if (buf[i++] == '\n')
+    if (buf[i++] == '\n' && !(f->flags & O_BINARY))
       break;
   }
 
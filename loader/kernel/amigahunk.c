@@ -1,8 +1,10 @@
 #include <amigahunk.h>
+#include <common.h>
 #include <strings.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
+#include <lz4.h>
 
 #define DEBUG 0
 
@@ -14,6 +16,8 @@
 #define HUNK_DEBUG 1009
 #define HUNK_END 1010
 #define HUNK_HEADER 1011
+/* Not an AmigaOS hunk type. Produced by tools/hunkpack. */
+#define HUNK_LZ4 1100
 
 #define HUNKF_CHIP __BIT(30)
 #define HUNKF_FAST __BIT(31)
@@ -42,9 +46,9 @@ static bool AllocHunks(FileT *fh, HunkT **hunkArray, short hunkCount) {
     if (!hunk)
       return false;
 
+    /* Hunk contents is cleared as it gets loaded. */
     hunk->size = n * sizeof(int);
     hunk->next = NULL;
-    bzero(hunk->data, n * sizeof(int));
 
     if (prev)
       prev->next = hunk;
@@ -55,6 +59,55 @@ static bool AllocHunks(FileT *fh, HunkT **hunkArray, short hunkCount) {
   return true;
 }
 
+/* Code and data hunks can be shorter than declared in the header. */
+static void ClearTail(HunkT *hunk, u_int size) {
+  if (size < hunk->size)
+    bzero(hunk->data + size, hunk->size - size);
+}
+
+static bool LoadPackedHunk(FileT *fh, HunkT *hunk) {
+  int n, size;
+  void *packed;
+
+  SkipLongs(fh, 1); /* type of hunk before compression */
+  n = ReadLong(fh);
+  size = ReadLong(fh) * sizeof(int);
+
+  if (!(packed = MemAlloc(size, MEMF_PUBLIC)))
+    return false;
+
+  FileRead(fh, packed, size);
+  (void)Lz4Unpack(packed, hunk->data);
+  MemFree(packed);
+
+  ClearTail(hunk, n * sizeof(int));
+  return true;
+}
+
+#define RELOC_BATCH 64
+
+static void Relocate(FileT *fh, HunkT *hunk, HunkT **hunkArray) {
+  u_int offsets[RELOC_BATCH];
+  int n;
+
+  while ((n = ReadLong(fh))) {
+    int hunkNum = ReadLong(fh);
+    int32_t hunkRef = (int32_t)hunkArray[hunkNum]->data;
+
+    /* Apply relocations in batches read with a single call. */
+    do {
+      short k = min(n, RELOC_BATCH);
+      u_int *offset = offsets;
+
+      FileRead(fh, offsets, k * sizeof(u_int));
+      n -= k;
+
+      while (--k >= 0)
+        *(int32_t *)(hunk->data + *offset++) += hunkRef;
+    } while (n > 0);
+  }
+}
+
 static bool LoadHunks(FileT *fh, HunkT **hunkArray) {
   int hunkIndex = 0;
   HunkT *hunk = hunkArray[hunkIndex++];
@@ -67,8 +120,12 @@ static bool LoadHunks(FileT *fh, HunkT **hunkArray) {
     if (hunkId == HUNK_CODE || hunkId == HUNK_DATA || hunkId == HUNK_BSS) {
       hunkRoot = true;
       n = ReadLong(fh);
-      if (hunkId != HUNK_BSS)
+      if (hunkId != HUNK_BSS) {
         FileRead(fh, hunk->data, n * sizeof(int));
+        ClearTail(hunk, n * sizeof(int));
+      } else {
+        bzero(hunk->data, hunk->size);
+      }
 #if DEBUG
       {
         const char *hunkType;
@@ -83,19 +140,15 @@ static bool LoadHunks(FileT *fh, HunkT **hunkArray) {
         printf("%s: %p - %p\n", hunkType, hunk->data, hunk->data + hunk->size);
       }
 #endif
+    } else if (hunkId == HUNK_LZ4) {
+      hunkRoot = true;
+      if (!LoadPackedHunk(fh, hunk))
+        return false;
     } else if (hunkId == HUNK_DEBUG) {
       n = ReadLong(fh);
       SkipLongs(fh, n);
     } else if (hunkId == HUNK_RELOC32) {
-      while ((n = ReadLong(fh))) {
-        int hunkNum = ReadLong(fh);
-        int32_t hunkRef = (int32_t)hunkArray[hunkNum]->data;
-        do {
-          int hunkOff = ReadLong(fh);
-          int32_t *ptr = (void *)hunk->data + hunkOff;
-          *ptr += hunkRef;
-        } while (--n);
-      }
+      Relocate(fh, hunk, hunkArray);
     } else if (hunkId == HUNK_SYMBOL) {
       while ((n = ReadLong(fh)))
         SkipLongs(fh, n + 1);
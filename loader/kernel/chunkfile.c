@@ -0,0 +1,119 @@
+#include <debug.h>
+#include <memory.h>
+#include <errno.h>
+#include <chunkfile.h>
+#include <inflate.h>
+#include <lz4.h>
+
+#define CHUNK_MAGIC 0x43484e4b /* 'CHNK' */
+
+typedef struct {
+  u_int magic;
+  u_short count;
+  u_short pad;
+  u_int maxSize;
+  u_int maxLength;
+} ChunkFileHeaderT;
+
+ChunkFileT *ChunkFileOpen(FileT *file) {
+  ChunkFileHeaderT hdr;
+  ChunkFileT *cf;
+  int size;
+
+  if (FileRead(file, &hdr, sizeof(hdr)) != sizeof(hdr) ||
+      hdr.magic != CHUNK_MAGIC)
+  {
+    Log("[ChunkFile] Not a chunk container!\n");
+    FileClose(file);
+    return NULL;
+  }
+
+  size = (hdr.count + 1) * sizeof(ChunkT);
+
+  cf = MemAlloc(sizeof(ChunkFileT) + size, MEMF_PUBLIC);
+  cf->file = file;
+  cf->count = hdr.count;
+  cf->maxSize = hdr.maxSize;
+  cf->maxLength = hdr.maxLength;
+  cf->packed = NULL;
+
+  if (FileRead(file, cf->chunk, size) != size) {
+    Log("[ChunkFile] Truncated chunk index!\n");
+    ChunkFileClose(cf);
+    return NULL;
+  }
+
+  /* Only compressed chunks need intermediate buffer. */
+  {
+    ChunkT *chunk = cf->chunk;
+    short n = cf->count;
+
+    while (--n >= 0) {
+      if ((chunk++)->method != CHUNK_STORED) {
+        cf->packed = MemAlloc(cf->maxSize, MEMF_PUBLIC);
+        break;
+      }
+    }
+  }
+
+  Log("[ChunkFile] %d chunks, largest is %d bytes.\n",
+      cf->count, cf->maxLength);
+
+  return cf;
+}
+
+void ChunkFileClose(ChunkFileT *cf) {
+  if (cf->packed)
+    MemFree(cf->packed);
+  FileClose(cf->file);
+  MemFree(cf);
+}
+
+int ChunkRead(ChunkFileT *cf, short num, void *buf) {
+  ChunkT *chunk;
+  int size, err;
+
+  if (num < 0 || num >= cf->count)
+    return EINVAL;
+
+  chunk = &cf->chunk[num];
+  size = chunk[1].offset - chunk->offset;
+
+  if ((err = FileSeek(cf->file, chunk->offset, SEEK_SET)) < 0)
+    return err;
+
+  if (chunk->method == CHUNK_STORED) {
+    if (FileRead(cf->file, buf, chunk->length) != (int)chunk->length)
+      return EIO;
+    return chunk->length;
+  }
+
+  if (FileRead(cf->file, cf->packed, size) != size)
+    return EIO;
+
+  if (chunk->method == CHUNK_LZ4)
+    (void)Lz4Unpack(cf->packed, buf);
+  else if (chunk->method == CHUNK_DEFLATE)
+    Inflate(cf->packed, buf);
+  else
+    return ENOTSUP;
+
+  return chunk->length;
+}
+
+void *ChunkLoad(ChunkFileT *cf, short num, u_int memoryFlags) {
+  void *data;
+
+  if (num < 0 || num >= cf->count)
+    return NULL;
+
+  if (!(data = MemAlloc(cf->chunk[num].length, memoryFlags)))
+    return NULL;
+
+  if (ChunkRead(cf, num, data) < 0) {
+    MemFree(data);
+    return NULL;
+  }
+
+  return data;
+}
@@ -15,16 +15,20 @@ void _ProfilerStop(ProfileT *prof) {
   if (lines > 32767)
     lines = -lines;
 
-  if (lines < prof->min)
-    prof->min = lines;
-  if (lines > prof->max)
-    prof->max = lines;
+  _ProfilerCount(prof, lines);
+}
+
+void _ProfilerCount(ProfileT *prof, u_short value) {
+  if (value < prof->min)
+    prof->min = value;
+  if (value > prof->max)
+    prof->max = value;
 
-  prof->total += lines;
+  prof->total += value;
   prof->count++;
 
   /* Report every second! */
   if (div16(lastFrameCount, 50) < div16(frameCount, 50))
-    Log("%s took %d-%d-%d (min-avg-max) raster lines.\n",
-        prof->name, prof->min, div16(prof->total, prof->count), prof->max);
+    Log("%s took %d-%d-%d (min-avg-max) %s.\n", prof->name, prof->min,
+        div16(prof->total, prof->count), prof->max, prof->unit);
 }
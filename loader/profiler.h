@@ -5,18 +5,26 @@
 
 typedef struct Profile {
   const char *name;
+  const char *unit;
   u_int lines, total;
   u_short min, max;
   u_short count;
 } ProfileT;
 
-#define PROFILE(NAME)                                                          \
+#define PROFILE_COUNTER(NAME, UNIT)                                            \
   static ProfileT *_##NAME##_profile = &(ProfileT){                            \
-    .name = #NAME, .lines = 0, .total = 0, .min = 65535, .max = 0, .count = 0};
+    .name = #NAME, .unit = UNIT, .lines = 0, .total = 0,                       \
+    .min = 65535, .max = 0, .count = 0};
+
+#define PROFILE(NAME) PROFILE_COUNTER(NAME, "raster lines")
 
 #define ProfilerStart(NAME) _ProfilerStart(_##NAME##_profile)
 #define ProfilerStop(NAME) _ProfilerStop(_##NAME##_profile)
 void _ProfilerStart(ProfileT *prof);
 void _ProfilerStop(ProfileT *prof);
 
+/* Records a value of a counter declared with PROFILE_COUNTER. */
+#define ProfilerCount(NAME, VALUE) _ProfilerCount(_##NAME##_profile, VALUE)
+void _ProfilerCount(ProfileT *prof, u_short value);
+
 #endif
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+
+import argparse
+import os.path
+import zlib
+from struct import pack
+
+import lz4
+
+#
+# Chunk container format (see include/chunkfile.h):
+#
+# [LONG] 'CHNK'
+# [WORD] number of chunks (n)
+# [WORD] reserved
+# [LONG] size of the largest chunk as stored
+# [LONG] size of the largest chunk after decompression
+# (n + 1) times:
+#  [LONG] offset : position of chunk data in container (2-byte aligned)
+#  [LONG] length : size of chunk after decompression
+#  [WORD] method : 0 = stored, 1 = LZ4, 2 = DEFLATE
+#  [WORD] reserved
+# chunk data
+#
+# Last index entry only marks the end of chunk data.
+#
+
+STORED = 0
+LZ4 = 1
+DEFLATE = 2
+
+METHODS = {'none': STORED, 'lz4': LZ4, 'deflate': DEFLATE}
+
+
+def align(size, alignment=2):
+    return (size + alignment - 1) // alignment * alignment
+
+
+def deflate(data):
+    co = zlib.compressobj(9, zlib.DEFLATED, -15)
+    return co.compress(data) + co.flush()
+
+
+def compress(data, method):
+    if method == LZ4:
+        packed = lz4.compress(data)
+        assert lz4.decompress(packed) == data
+    elif method == DEFLATE:
+        packed = deflate(data)
+    else:
+        packed = data
+    # Fall back to storing a chunk if compression does not pay off.
+    if len(packed) >= len(data):
+        return STORED, data
+    return method, packed
+
+
+def split(paths, size):
+    chunks = []
+    for path in paths:
+        if not os.path.isfile(path):
+            raise SystemExit('Input file "%s" does not exist!' % path)
+        with open(path, 'rb') as f:
+            data = f.read()
+        if size:
+            chunks.extend(data[i:i + size] for i in range(0, len(data), size))
+        else:
+            chunks.append(data)
+    return chunks
+
+
+def build(chunks, method):
+    packed = [compress(data, method) for data in chunks]
+    count = len(chunks)
+
+    header_size = 16 + (count + 1) * 12
+    offset = header_size
+    index = []
+    for data, (m, p) in zip(chunks, packed):
+        index.append((offset, len(data), m))
+        offset = align(offset + len(p))
+    index.append((offset, 0, STORED))
+
+    maxSize = max([len(p) for m, p in packed if m != STORED] or [0])
+    maxLength = max([len(data) for data in chunks] or [0])
+
+    out = bytearray()
+    out.extend(pack('>4sHxxII', b'CHNK', count, maxSize, maxLength))
+    for offset, length, m in index:
+        out.extend(pack('>IIHxx', offset, length, m))
+    for m, p in packed:
+        out.extend(p)
+        out.extend(b'\0' * (align(len(out)) - len(out)))
+    return out, packed
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Creates container of individually compressed chunks.')
+    parser.add_argument('-m', '--method', choices=METHODS.keys(),
+                        default='lz4', help='Compression method.')
+    parser.add_argument('-s', '--split', metavar='SIZE', type=int, default=0,
+                        help='Cut input files into chunks of SIZE bytes. '
+                             'By default each input file is one chunk.')
+    parser.add_argument('output', metavar='OUTPUT', type=str,
+                        help='Output filename.')
+    parser.add_argument('inputs', metavar='INPUT', type=str, nargs='+',
+                        help='Input filenames.')
+    args = parser.parse_args()
+
+    if args.split < 0 or args.split % 2:
+        raise SystemExit('Chunk size must be positive and even!')
+
+    chunks = split(args.inputs, args.split)
+    if len(chunks) > 32767:
+        raise SystemExit('Too many chunks!')
+
+    out, packed = build(chunks, METHODS[args.method])
+
+    with open(args.output, 'wb') as f:
+        f.write(out)
+
+    total = sum(len(c) for c in chunks)
+    print('%d chunks, %d bytes -> %d bytes' % (len(chunks), total, len(out)))
@@ -0,0 +1,463 @@
+#!/usr/bin/env python3
+
+"""
+Compiles static copper list descriptions into C data placed in chip memory.
+Lists come out fully built, i.e. with exact length and terminated, so effect
+initialization does not have to build them and they can never overflow.
+
+Description consists of lines with following statements:
+
+  list NAME [COPIES]  start a list, COPIES > 1 gives an array of lists
+  set NAME EXPR       define a constant
+  for VAR START STOP  repeat statements till matching 'end' for each VAR
+  end                 in range START..STOP-1
+  if EXPR             include statements till matching 'end' only if EXPR
+  end                 is not zero
+  slot NAME           instruction that follows can be accessed from C
+  move REG EXPR       same as CopMove16 / CopMove32 (for pointer registers)
+  wait VP HP          same as CopWait
+  waitsafe VP HP      same as CopWaitSafe
+  nop                 same as CopNoOp
+  reserve N           leave room for N instructions (including CopEnd) to be
+                      added in runtime, list is not terminated in that case
+
+Registers are named like fields of 'struct Custom', e.g. 'color[i]' or
+'spr[2].pos'. Arguments are separated by spaces, so an expression that has
+spaces must be put in parentheses, unless it is the last argument of 'set',
+'move' or 'if'. Expressions are evaluated in Python with X, Y, HP and VP
+functions defined as in effect.h. Value of 'move' that cannot be evaluated
+is passed to C compiler as is, so it can refer to C constants. Constants can
+also be given on command line with -D NAME=VALUE, e.g. to share them with C
+code of an effect through its Makefile.
+
+For each list NAME the tool defines NAME macro (or NAME(n) for arrays of
+lists) that gives CopListT pointer. For each slot SLOT there is NAME_SLOT
+macro, which takes index of instruction as argument if slot was used more
+than once, and list number as first argument for arrays of lists.
+"""
+
+import argparse
+import os.path
+import re
+
+from collections import namedtuple
+
+
+LASTHP = 0xDE
+MAXVP = 311
+
+# (offset, pointer) of registers copper can write to, see custom_regdef.h
+REGS = {
+    'bltcon0': (0x040, False), 'bltcon1': (0x042, False),
+    'bltafwm': (0x044, False), 'bltalwm': (0x046, False),
+    'bltcpt': (0x048, True), 'bltbpt': (0x04c, True),
+    'bltapt': (0x050, True), 'bltdpt': (0x054, True),
+    'bltsize': (0x058, False), 'bltsizv': (0x05c, False),
+    'bltsizh': (0x05e, False),
+    'bltcmod': (0x060, False), 'bltbmod': (0x062, False),
+    'bltamod': (0x064, False), 'bltdmod': (0x066, False),
+    'bltcdat': (0x070, False), 'bltbdat': (0x072, False),
+    'bltadat': (0x074, False),
+    'cop1lc': (0x080, True), 'cop2lc': (0x084, True),
+    'copjmp1': (0x088, False), 'copjmp2': (0x08a, False),
+    'diwstrt': (0x08e, False), 'diwstop': (0x090, False),
+    'ddfstrt': (0x092, False), 'ddfstop': (0x094, False),
+    'dmacon': (0x096, False), 'clxcon': (0x098, False),
+    'intena_': (0x09a, False), 'intreq_': (0x09c, False),
+    'adkcon': (0x09e, False),
+    'bplcon0': (0x100, False), 'bplcon1': (0x102, False),
+    'bplcon2': (0x104, False), 'bplcon3': (0x106, False),
+    'bpl1mod': (0x108, False), 'bpl2mod': (0x10a, False),
+    'bplcon4': (0x10c, False), 'clxcon2': (0x10e, False),
+    'htotal': (0x1c0, False), 'hsstop': (0x1c2, False),
+    'hbstrt': (0x1c4, False), 'hbstop': (0x1c6, False),
+    'vtotal': (0x1c8, False), 'vsstop': (0x1ca, False),
+    'vbstrt': (0x1cc, False), 'vbstop': (0x1ce, False),
+    'sprhstrt': (0x1d0, False), 'sprhstop': (0x1d2, False),
+    'bplhstrt': (0x1d4, False), 'bplhstop': (0x1d6, False),
+    'hhposw': (0x1d8, False), 'beamcon0': (0x1dc, False),
+    'hsstrt': (0x1de, False), 'vsstrt': (0x1e0, False),
+    'hcenter': (0x1e2, False), 'diwhigh': (0x1e4, False),
+    'fmode': (0x1fc, False),
+}
+
+# name: (offset, element size, count, fields)
+ARRAYS = {
+    'aud': (0x0a0, 16, 4, {'ac_ptr': (0, True), 'ac_len': (4, False),
+                           'ac_per': (6, False), 'ac_vol': (8, False),
+                           'ac_dat': (10, False)}),
+    'bplpt': (0x0e0, 4, 8, True),
+    'bpldat': (0x110, 2, 8, False),
+    'sprpt': (0x120, 4, 8, True),
+    'spr': (0x140, 8, 8, {'pos': (0, False), 'ctl': (2, False),
+                          'dataa': (4, False), 'datab': (6, False)}),
+    'color': (0x180, 2, 32, False),
+}
+
+BUILTINS = {
+    'X': lambda x: x + 0x81,
+    'Y': lambda y: y + 0x2c,
+    'HP': lambda x: (x + 0x81) // 2,
+    'VP': lambda y: (y + 0x2c) & 255,
+    'abs': abs, 'min': min, 'max': max,
+}
+
+Move = namedtuple('Move', 'reg data')
+Wait = namedtuple('Wait', 'vp hp')
+
+
+class CopperError(Exception):
+    pass
+
+
+class CopList():
+    def __init__(self, name, copies):
+        self.name = name
+        self.copies = copies
+        self.ins = []
+        self.slots = {}
+        self.pending = []
+        self.overflow = False
+        self.reserve = None
+
+    def add(self, ins):
+        if self.reserve is not None:
+            raise CopperError('no instructions allowed after "reserve"')
+        for slot in self.pending:
+            self.slots.setdefault(slot, []).append(len(self.ins))
+        self.pending = []
+        self.ins.append(ins)
+
+    def move(self, reg, data):
+        self.add(Move(reg, data))
+
+    def wait(self, vp, hp, safe):
+        if vp < 0 or vp > MAXVP:
+            raise CopperError('vertical position %d out of range' % vp)
+        if hp < 0 or hp > LASTHP:
+            raise CopperError('horizontal position %d out of range' % hp)
+        if safe and vp > 255 and not self.overflow:
+            self.overflow = True
+            self.add(Wait(0xff, 0xdf))
+        self.add(Wait(vp & 255, hp | 1))
+
+    def finish(self):
+        if self.pending:
+            raise CopperError('slot "%s" not followed by an instruction' %
+                              self.pending[0])
+        if self.reserve is None:
+            self.add(Wait(0xff, 0xff))
+            self.length = len(self.ins)
+        else:
+            self.length = len(self.ins) + self.reserve
+
+
+def register(spec, env):
+    m = re.match(r'^(\w+)(?:\[(.+?)\])?(?:\.(\w+))?$', spec)
+    if not m:
+        raise CopperError('malformed register "%s"' % spec)
+    name, index, field = m.groups()
+
+    if name in ('intena', 'intreq'):
+        name += '_'
+
+    if name in REGS:
+        if index is not None or field is not None:
+            raise CopperError('register "%s" is not an array' % name)
+        return REGS[name]
+
+    if name not in ARRAYS:
+        raise CopperError('unknown register "%s"' % name)
+
+    offset, size, count, kind = ARRAYS[name]
+    if index is None:
+        raise CopperError('register "%s" needs an index' % name)
+    index = evaluate(index, env)
+    if index < 0 or index >= count:
+        raise CopperError('index %d of "%s" out of range' % (index, name))
+    offset += index * size
+
+    if isinstance(kind, dict):
+        if field not in kind:
+            raise CopperError('"%s" has no field "%s"' % (name, field))
+        delta, pointer = kind[field]
+        return (offset + delta, pointer)
+
+    if field is not None:
+        raise CopperError('"%s" has no fields' % name)
+    return (offset, kind)
+
+
+def evaluate(expr, env):
+    try:
+        value = eval(expr, {'__builtins__': {}}, env)
+    except Exception as ex:
+        raise CopperError('cannot evaluate "%s": %s' % (expr, ex))
+    if not isinstance(value, int):
+        raise CopperError('"%s" is not an integer' % expr)
+    return value
+
+
+def data(expr, env):
+    try:
+        return '0x%04x' % (evaluate(expr, env) & 0xffff)
+    except CopperError:
+        # Hopefully a constant known to C compiler.
+        return '(%s)' % expr
+
+
+def split(text):
+    # Spaces within parentheses do not separate arguments.
+    args, depth, arg = [], 0, ''
+    for c in text:
+        depth += {'(': 1, ')': -1}.get(c, 0)
+        if c.isspace() and depth == 0:
+            if arg:
+                args.append(arg)
+            arg = ''
+        else:
+            arg += c
+    if arg:
+        args.append(arg)
+    return args
+
+
+def compile(lines, defines):
+    lists = []
+    env = dict(BUILTINS)
+    env.update(defines)
+    loops = []
+    cp = None
+    pc = 0
+
+    def words(n, m=None):
+        if len(args) < n or len(args) > (m or n):
+            raise CopperError('"%s" takes %d arguments' % (cmd, n))
+
+    def skip(pc):
+        depth = 1
+        while depth and pc < len(lines):
+            s = lines[pc][1].split()[0]
+            depth += {'for': 1, 'if': 1, 'end': -1}.get(s, 0)
+            pc += 1
+        return pc
+
+    while pc < len(lines):
+        lineno, line = lines[pc]
+        pc += 1
+
+        try:
+            fields = line.split(None, 1)
+            cmd = fields[0]
+            if cmd == 'if':
+                args = fields[1:]
+            elif cmd in ('set', 'move'):
+                args = fields[1].split(None, 1) if len(fields) > 1 else []
+            else:
+                args = split(fields[1]) if len(fields) > 1 else []
+
+            if cmd == 'list':
+                words(1, 2)
+                if loops:
+                    raise CopperError('"list" inside of "%s" block' %
+                                      ('for' if loops[-1] else 'if'))
+                if cp:
+                    cp.finish()
+                copies = evaluate(args[1], env) if len(args) > 1 else 1
+                cp = CopList(args[0], copies)
+                lists.append(cp)
+                continue
+
+            if cmd == 'set':
+                words(2)
+                env[args[0]] = evaluate(args[1], env)
+                continue
+
+            if cmd == 'for':
+                words(3)
+                start = evaluate(args[1], env)
+                stop = evaluate(args[2], env)
+                if start < stop:
+                    env[args[0]] = start
+                    loops.append((args[0], stop, pc))
+                else:
+                    pc = skip(pc)
+                continue
+
+            if cmd == 'if':
+                words(1)
+                if evaluate(args[0], env):
+                    loops.append(None)
+                else:
+                    pc = skip(pc)
+                continue
+
+            if cmd == 'end':
+                words(0)
+                if not loops:
+                    raise CopperError('"end" without "for" or "if"')
+                if loops[-1] is None:
+                    loops.pop()
+                    continue
+                var, stop, start = loops[-1]
+                env[var] += 1
+                if env[var] < stop:
+                    pc = start
+                else:
+                    loops.pop()
+                continue
+
+            if cp is None:
+                raise CopperError('"%s" outside of list' % cmd)
+
+            if cmd == 'slot':
+                words(1)
+                if not re.match(r'^\w+$', args[0]):
+                    raise CopperError('malformed slot name "%s"' % args[0])
+                cp.pending.append(args[0])
+            elif cmd == 'move':
+                words(1, 2)
+                reg, pointer = register(args[0], env)
+                if reg < 0x40:
+                    raise CopperError('copper cannot write "%s"' % args[0])
+                value = args[1] if len(args) > 1 else '0'
+                if pointer:
+                    try:
+                        value = evaluate(value, env)
+                        hi, lo = '0x%04x' % (value >> 16), '0x%04x' % (
+                            value & 0xffff)
+                    except CopperError:
+                        hi = '(u_short)((u_int)(%s) >> 16)' % value
+                        lo = '(u_short)(u_int)(%s)' % value
+                    # low word goes first, as CopInsSet32 expects
+                    cp.move(reg + 2, lo)
+                    cp.move(reg, hi)
+                else:
+                    cp.move(reg, data(value, env))
+            elif cmd in ('wait', 'waitsafe'):
+                words(2)
+                vp = evaluate(args[0], env)
+                hp = evaluate(args[1], env)
+                cp.wait(vp, hp, cmd == 'waitsafe')
+            elif cmd == 'nop':
+                words(0)
+                cp.move(0x1fe, '0x0000')
+            elif cmd == 'reserve':
+                words(1)
+                cp.reserve = evaluate(args[0], env)
+            else:
+                raise CopperError('unknown statement "%s"' % cmd)
+        except CopperError as ex:
+            raise SystemExit('%s:%d: %s' % (args_.path, lineno, ex))
+
+    if loops:
+        raise SystemExit('%s: missing "end"' % args_.path)
+    if cp:
+        cp.finish()
+
+    return lists
+
+
+def emit(cp):
+    name = cp.name
+    indexed = cp.copies > 1
+
+    print('static __data_chip struct {')
+    print('  CopListT list;')
+    print('  CopInsT entry[%d];' % cp.length)
+    if indexed:
+        print('} _%s[%d] = {' % (name, cp.copies))
+    else:
+        print('} _%s[1] = {' % name)
+
+    labels = {}
+    for slot, where in cp.slots.items():
+        for i, pos in enumerate(where):
+            label = slot if len(where) == 1 else '%s[%d]' % (slot, i)
+            labels.setdefault(pos, []).append(label)
+
+    for n in range(cp.copies):
+        print('  {')
+        print('    .list = {')
+        print('      .curr = &_%s[%d].entry[%d],' % (name, n, len(cp.ins)))
+        print('      .length = %d,' % cp.length)
+        print('      .overflow = %d,' % (255 if cp.overflow else 0))
+        print('    },')
+        print('    .entry = {')
+        for pos, ins in enumerate(cp.ins):
+            if pos in labels:
+                print('      /* %s */' % ', '.join(labels[pos]))
+            if isinstance(ins, Move):
+                print('      { .move = { 0x%03x, %s } },' % (ins.reg, ins.data))
+            else:
+                print('      { .wait = { 0x%02x, 0x%02x, 0xff, 0xfe } },' %
+                      (ins.vp, ins.hp))
+        print('    }')
+        print('  },')
+    print('};')
+    print('')
+
+    list_arg = 'n' if indexed else '0'
+    if indexed:
+        print('#define %s(n) (&_%s[n].list)' % (name, name))
+    else:
+        print('#define %s (&_%s[0].list)' % (name, name))
+
+    for slot, where in cp.slots.items():
+        macro = '%s_%s' % (name, slot)
+        args = ['n'] if indexed else []
+        if len(where) == 1:
+            index = str(where[0])
+        else:
+            args.append('i')
+            stride = where[1] - where[0]
+            regular = all(b - a == stride for a, b in zip(where, where[1:]))
+            if regular:
+                index = '(i) * %d' % stride
+                if where[0]:
+                    index = '%d + %s' % (where[0], index)
+            else:
+                print('static const short _%s[%d] = {' % (macro, len(where)))
+                for i in range(0, len(where), 8):
+                    print('  %s,' % ', '.join(map(str, where[i:i + 8])))
+                print('};')
+                index = '_%s[i]' % macro
+            print('#define %s_count %d' % (macro, len(where)))
+        print('#define %s%s (&_%s[%s].entry[%s])' % (
+            macro, '(%s)' % ', '.join(args) if args else '', name,
+            list_arg, index))
+    print('')
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Compile copper list descriptions into C data.')
+    parser.add_argument('-D', metavar='NAME=VALUE', dest='defines',
+                        action='append', default=[],
+                        help='Define a constant as if with "set".')
+    parser.add_argument('path', metavar='PATH', type=str,
+                        help='Copper list description file.')
+    args_ = parser.parse_args()
+
+    if not os.path.isfile(args_.path):
+        raise SystemExit('Input file does not exists!')
+
+    defines = {}
+    for define in args_.defines:
+        name, _, value = define.partition('=')
+        if not re.match(r'^[A-Za-z_]\w*$', name) or not value:
+            raise SystemExit('Malformed define "%s"!' % define)
+        try:
+            defines[name] = evaluate(value, BUILTINS)
+        except CopperError as ex:
+            raise SystemExit(str(ex))
+
+    lines = []
+    with open(args_.path) as f:
+        for lineno, line in enumerate(f, start=1):
+            line = line.split('#', 1)[0].strip()
+            if line:
+                lines.append((lineno, line))
+
+    for cp in compile(lines, defines):
+        emit(cp)
@@ -2,6 +2,7 @@
 
 import argparse
 import os
+import re
 import stat
 from array import array
 from fnmatch import fnmatch
@@ -19,7 +20,7 @@ from io import BytesIO
 #
 # sector 2..(n+1): directory entries (take n sectors)
 #  [WORD] dirsize : total size of directory entries in bytes
-#  for each directory entry (2-byte aligned):
+#  for each directory entry (2-byte aligned, sorted by name):
 #   [BYTE] #reclen : total size of this record
 #   [BYTE] #type   : type of file (1: executable, 0: regular)
 #   [WORD] #start  : sector where the file begins (0..1759)
@@ -27,14 +28,29 @@ from io import BytesIO
 #   [STRING] #name : name of the file (NUL terminated)
 #
 # sector (n+2)..(n+m+1): executable file in AmigaHunk format
-#  the file is assumed to be first in the directory
+#  the file is stored first, boot block header points at it, so it is loaded
+#  without a directory lookup; other files are found by binary search over
+#  directory entries
 #
 # sector (m+n+2)..1759: data
+#  files are stored contiguously in the order they're loaded (if known)
+#
+# Logical track number is cylinder * 2 + side, so consecutive tracks fill both
+# sides of a cylinder before heads have to move.
 #
 
 SECTOR = 512
+TRACK = SECTOR * 11
 FLOPPY = SECTOR * 80 * 11 * 2
 
+# Timings (in milliseconds) of loader/drivers/floppy.c
+STEP_SETTLE = 3
+DIRECTION_REVERSE_SETTLE = 18
+DISK_SETTLE = 15
+TRACK_READ = 205  # 12800 bytes at 500kbit/s
+SYNC_WAIT = 9  # on average half of sector must pass under heads
+TRACK_DECODE = 10
+
 
 def align(size, alignment=None):
     if alignment is None:
@@ -103,6 +119,72 @@ def collect(paths):
     return entries
 
 
+def read_order(path):
+    """
+    Reads load order manifest. Each line is a file name. Log of a previous
+    run can be used as well, in which case files are taken from lines
+    written by OpenFile in loader/drivers/filesys.c.
+    """
+    order = []
+    with open(path) as fh:
+        for line in fh:
+            match = re.search(r"\[FileSys\] Open '([^']+)'", line)
+            if match:
+                name = match.group(1)
+            elif '[' in line:
+                continue
+            else:
+                name = line.split('#')[0].strip()
+            if name and name not in order:
+                order.append(name)
+    return order
+
+
+def arrange(entries, order):
+    # executable must come first as boot code loads it
+    head = [entries[0]] if entries and entries[0].exe else []
+    rest = [e for e in entries if e not in head]
+    byname = {e.name: e for e in rest}
+    for name in order:
+        if name not in byname:
+            print('create: %s from load order is not in archive' % name)
+    ordered = [byname[name] for name in order if name in byname]
+    return head + ordered + [e for e in rest if e not in ordered]
+
+
+def predict(entries, offsets, dir_len):
+    """
+    Simulates floppy driver reading directory and then whole files in the
+    order they are stored on disk. Returns predicted time in milliseconds.
+    """
+    reads = [(2 * SECTOR, 2 + dir_len)]
+    reads.extend((offset, len(e)) for e, offset in zip(entries, offsets))
+
+    time = 0
+    current = -1  # track in MFM buffer
+    cylinder = 0  # InitFloppy leaves heads at cylinder 0...
+    inwards = True  # ...stepping inwards
+    for offset, size in reads:
+        first = offset // TRACK
+        last = (offset + max(size, 1) - 1) // TRACK
+        for num in range(first, last + 1):
+            if num == current:
+                # track is still in MFM buffer, only decode it again
+                time += TRACK_DECODE
+                continue
+            target = num // 2
+            if target != cylinder:
+                # heads settle only when stepping direction changes
+                if (target > cylinder) != inwards:
+                    inwards = not inwards
+                    time += DIRECTION_REVERSE_SETTLE
+                time += abs(target - cylinder) * STEP_SETTLE
+                cylinder = target
+            time += DISK_SETTLE + SYNC_WAIT + TRACK_READ + TRACK_DECODE
+            current = num
+    return time
+
+
 def load(archive):
     with open(archive, 'rb') as fh:
         fh.seek(2 * SECTOR)
@@ -124,7 +206,7 @@ def load(archive):
         return entries
 
 
-def save(archive, entries, bootcode=None):
+def save(archive, entries, bootcode=None, order=None):
     # Collect boot code if there's any...
     if bootcode is not None:
         if os.path.isfile(bootcode):
@@ -139,20 +221,27 @@ def save(archive, entries, bootcode=None):
     else:
         bootcode = ''
 
+    # Files are stored in load order, directory is sorted by name
+    entries = arrange(entries, order or [])
+    dirents = sorted(entries, key=lambda e: e.name.encode('ascii'))
+
     dir_len = 0
     files_len = 0
-    files_off = []
+    files_off = {}
 
     for entry in entries:
         # Determine dirent size
         dir_len += align(8 + len(entry.name) + 1, 2)
         # Determine file position
-        files_off.append(files_len)
+        files_off[entry.name] = files_len
         files_len += align(len(entry.data))
 
     # Calculate starting position of files in the file system image
     files_pos = align(dir_len) + 2 * SECTOR
 
+    if files_pos + files_len > FLOPPY:
+        raise SystemExit('Files do not fit on a floppy disk!')
+
     with open(archive, 'wb') as fh:
         boot = BytesIO(bootcode)
         # Overwrite boot block header
@@ -172,8 +261,8 @@ def save(archive, entries, bootcode=None):
         # Write directory header
         fh.write(pack('>H', dir_len))
         # Write directory entries
-        for entry, file_off in zip(entries, files_off):
-            file_off += files_pos
+        for entry in dirents:
+            file_off = files_off[entry.name] + files_pos
             start = sectors(file_off)
             reclen = align(8 + len(entry.name) + 1, 2)
             name = entry.name.encode('ascii') + b'\0'
@@ -191,6 +280,10 @@ def save(archive, entries, bootcode=None):
         # Complete floppy disk image
         write_pad(fh, FLOPPY)
 
+    offsets = [files_off[e.name] + files_pos for e in entries]
+    time = predict(entries, offsets, dir_len)
+    print('Predicted load time: %.2fs' % (time / 1000.0))
+
 
 def extract(archive, patterns, force):
     for pattern in patterns:
@@ -219,6 +312,9 @@ if __name__ == '__main__':
     parser.add_argument(
         '-b', '--bootcode', metavar='BOOTCODE', type=str,
         help='Boot code to be embedded into floppy disk representation.')
+    parser.add_argument(
+        '-o', '--order', metavar='ORDER', type=str,
+        help='Load order manifest or a log of a run that accessed files.')
     parser.add_argument(
         'image', metavar='IMAGE', type=str,
         help='File system image file.')
@@ -231,7 +327,8 @@ if __name__ == '__main__':
         archive = collect(args.files)
         for entry in archive:
             print(entry)
-        save(args.image, archive, args.bootcode)
+        order = read_order(args.order) if args.order else None
+        save(args.image, archive, args.bootcode, order)
     elif args.action == 'list':
         archive = load(args.image)
         for entry in archive:
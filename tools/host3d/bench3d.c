@@ -0,0 +1,161 @@
+#include <string.h>
+#include <strings.h>
+#include <fx.h>
+#include "host.h"
+
+/*
+ * Measures time that pipeline stages take on the host. Absolute numbers say
+ * little about the Amiga, but relative ones are good enough to compare two
+ * versions of an algorithm before trying it in the emulator.
+ */
+
+#define FRAMES 1000
+
+typedef enum {
+  TRANSFORM,
+  FACE_VISIBILITY,
+  VERTEX_VISIBILITY,
+  EDGE_VISIBILITY,
+  PROJECT,
+  SORT_FACES,
+  ORDER_FACES,
+  RADIX_SORT,
+  QUICK_SORT,
+  TRANSFORM3D,
+  CLIP_FLAGS,
+  CLIP_FACES,
+  STAGES
+} StageT;
+
+static const char *StageName[STAGES] = {
+  "UpdateObjectTransformation",
+  "UpdateFaceVisibility",
+  "UpdateVertexVisibility",
+  "UpdateEdgeVisibility",
+  "ProjectObject3D",
+  "SortFaces",
+  "OrderFaces",
+  "RadixSortItemArray",
+  "SortItemArray",
+  "Transform3D",
+  "UpdateClipFlags",
+  "ClipFace3D",
+};
+
+static u_long elapsed[STAGES];
+
+#define TIMED(stage, stmt) {                                                   \
+  u_long _start = HostNanoTime();                                              \
+  stmt;                                                                        \
+  elapsed[stage] += HostNanoTime() - _start;                                   \
+}
+
+static void Frame(Object3D *object, short frame) {
+  static SortItemT item[SCENE_FACE_MASK + 1];
+  static SortItemT temp[SCENE_FACE_MASK + 1];
+  Mesh3D *mesh = object->mesh;
+  short r = min(HostMeshRadius(mesh), (short)8000);
+  short n;
+
+  object->rotate.x = frame * 8;
+  object->rotate.y = frame * 12;
+  object->rotate.z = frame * 4;
+  object->translate.x = 0;
+  object->translate.y = 0;
+  object->translate.z = -HostMeshDistance(mesh);
+
+  TIMED(TRANSFORM, UpdateObjectTransformation(object));
+  TIMED(FACE_VISIBILITY, UpdateFaceVisibility(object));
+  TIMED(VERTEX_VISIBILITY, UpdateVertexVisibility(object));
+  if (mesh->edges)
+    TIMED(EDGE_VISIBILITY, UpdateEdgeVisibility(object));
+  TIMED(SORT_FACES, SortFaces(object));
+  TIMED(PROJECT, ProjectObject3D(object, 160, 128));
+  TIMED(ORDER_FACES, OrderFaces(object));
+
+  n = object->visibleFaces;
+  memcpy(item, object->visibleFace, sizeof(SortItemT) * n);
+  TIMED(RADIX_SORT, RadixSortItemArray(item, temp, n));
+  memcpy(item, object->visibleFace, sizeof(SortItemT) * n);
+  if (n > 0)
+    TIMED(QUICK_SORT, SortItemArray(item, n));
+
+  /* Same movement across the frustum as in test3d. */
+  {
+    short a = frame * 24;
+
+    ClipFrustum.near = -r / 2;
+    ClipFrustum.far = -3 * r;
+
+    object->translate.x = normfx(SIN(a) * (short)(2 * r));
+    object->translate.y = normfx(COS(a * 3) * r);
+    object->translate.z = -3 * r / 2 + normfx(COS(a) * (short)(3 * r / 2));
+  }
+
+  UpdateObjectTransformation(object);
+  TIMED(TRANSFORM3D, Transform3D(&object->objectToWorld, object->vertex,
+                                 mesh->vertex, mesh->vertices));
+  {
+    u_char flags;
+
+    TIMED(CLIP_FLAGS, flags = UpdateClipFlags(object));
+
+    if (flags) {
+      u_long start = HostNanoTime();
+      for (n = 0; n < mesh->faces; n++) {
+        Point3D *out;
+        (void)ClipFace3D(object, n, &out);
+      }
+      elapsed[CLIP_FACES] += HostNanoTime() - start;
+    }
+  }
+}
+
+static void BenchMesh(HostMeshT *entry, short frames) {
+  Object3D *object = NewObject3D(entry->mesh);
+  short frame, i;
+
+  bzero(elapsed, sizeof(elapsed));
+
+  for (frame = 0; frame < frames; frame++)
+    Frame(object, frame);
+
+  printf("%s: %d vertices, %d faces, %d edges\n", entry->name,
+         entry->mesh->vertices, entry->mesh->faces, entry->mesh->edges);
+  for (i = 0; i < STAGES; i++)
+    printf("  %-28s %8lu ns/frame\n", StageName[i], elapsed[i] / frames);
+
+  DeleteObject3D(object);
+}
+
+static short ParseNumber(const char *s) {
+  short n = 0;
+  while (*s >= '0' && *s <= '9')
+    n = n * 10 + (*s++ - '0');
+  return n;
+}
+
+int main(int argc, char **argv) {
+  HostMeshT *entry;
+  short frames = FRAMES;
+  short i = 1;
+
+  if (i + 1 < argc && !strcmp(argv[i], "-n")) {
+    frames = max(ParseNumber(argv[i + 1]), (short)1);
+    i += 2;
+  }
+
+  if (i == argc)
+    for (entry = HostMesh; entry->name; entry++)
+      BenchMesh(entry, frames);
+
+  for (; i < argc; i++) {
+    if (!(entry = LookupHostMesh(argv[i]))) {
+      printf("%s: no such mesh\n", argv[i]);
+      return 1;
+    }
+    BenchMesh(entry, frames);
+  }
+
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Services of the Amiga runtime needed by lib2d and lib3d. This is the only
+ * file of the harness compiled against headers of the host, since those
+ * of the demo system only match its C library.
+ */
+
+void *MemAlloc(unsigned byteSize, unsigned attributes) {
+  void *ptr;
+
+  (void)attributes;
+
+  /* Memory is always cleared, so that results do not depend on garbage. */
+  if (!(ptr = calloc(1, byteSize ? byteSize : 1))) {
+    fprintf(stderr, "Failed to allocate %u bytes!\n", byteSize);
+    abort();
+  }
+
+  return ptr;
+}
+
+void MemFree(void *memoryBlock) {
+  free(memoryBlock);
+}
+
+void Log(const char *format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+}
+
+void Panic(const char *format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+  abort();
+}
+
+unsigned long HostNanoTime(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
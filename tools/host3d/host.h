@@ -0,0 +1,31 @@
+#ifndef __HOST_H__
+#define __HOST_H__
+
+#include <3d.h>
+
+/* Provided by the C library of the host. */
+int printf(const char *format, ...) __attribute__ ((format (printf, 1, 2)));
+
+/* Monotonic clock in nanoseconds, see host.c */
+u_long HostNanoTime(void);
+
+typedef struct {
+  const char *name;
+  Mesh3D *mesh;
+} HostMeshT;
+
+/*
+ * Meshes of effects converted by lwo2c with the same options their makefiles
+ * use, followed by a torus that is generated at startup, so that there is
+ * something to work on if git-lfs objects were not fetched. The list is
+ * terminated with an empty entry.
+ */
+extern HostMeshT HostMesh[];
+
+HostMeshT *LookupHostMesh(const char *name);
+
+/* Placement of an object that keeps projection within range of div16. */
+short HostMeshRadius(Mesh3D *mesh);
+short HostMeshDistance(Mesh3D *mesh);
+
+#endif
@@ -0,0 +1,102 @@
+#include <fx.h>
+#include <linkerset.h>
+#include <memory.h>
+#include <string.h>
+#include "host.h"
+
+#define MESH(name) extern Mesh3D name;
+#include "meshes.h"
+#undef MESH
+
+static Mesh3D torus;
+
+HostMeshT HostMesh[] = {
+#define MESH(name) { #name, &name },
+#include "meshes.h"
+#undef MESH
+  { "torus", &torus },
+  { NULL, NULL }
+};
+
+#define RINGS 24
+#define SIDES 12
+
+/* Torus of RINGS x SIDES quads, a typical mesh for face sorting. */
+static void InitTorus(void) {
+  Mesh3D *mesh = &torus;
+  Point3D *pt;
+  short *data;
+  short i, j;
+
+  mesh->vertices = RINGS * SIDES;
+  mesh->faces = RINGS * SIDES;
+  mesh->vertex = MemAlloc(sizeof(Point3D) * mesh->vertices, MEMF_PUBLIC);
+  mesh->face = MemAlloc(sizeof(IndexListT *) * (mesh->faces + 1), MEMF_PUBLIC);
+  data = MemAlloc(sizeof(short) * 5 * mesh->faces, MEMF_PUBLIC);
+
+  for (i = 0, pt = mesh->vertex; i < RINGS; i++) {
+    short a = i * SIN_PI * 2 / RINGS;
+
+    for (j = 0; j < SIDES; j++, pt++) {
+      short b = j * SIN_PI * 2 / SIDES;
+      short r = fx4i(64) + normfx(COS(b) * fx4i(26));
+
+      pt->x = normfx(COS(a) * r);
+      pt->y = normfx(SIN(a) * r);
+      pt->z = normfx(SIN(b) * fx4i(26));
+    }
+  }
+
+  for (i = 0; i < RINGS; i++) {
+    short i1 = (i + 1) % RINGS;
+
+    for (j = 0; j < SIDES; j++) {
+      short j1 = (j + 1) % SIDES;
+
+      mesh->face[i * SIDES + j] = (IndexListT *)data;
+      *data++ = 4;
+      *data++ = i * SIDES + j;
+      *data++ = i1 * SIDES + j;
+      *data++ = i1 * SIDES + j1;
+      *data++ = i * SIDES + j1;
+    }
+  }
+
+  CalculateEdges(mesh);
+  CalculateVertexFaceMap(mesh);
+  CalculateFaceNormals(mesh);
+  CalculateVertexNormals(mesh);
+}
+
+ADD2INIT(InitTorus, 1);
+
+HostMeshT *LookupHostMesh(const char *name) {
+  HostMeshT *entry;
+
+  for (entry = HostMesh; entry->name; entry++)
+    if (!strcmp(entry->name, name))
+      return entry;
+
+  return NULL;
+}
+
+short HostMeshRadius(Mesh3D *mesh) {
+  Point3D *pt = mesh->vertex;
+  short n = mesh->vertices;
+  short r = 0;
+
+  while (--n >= 0) {
+    r = max(r, absw(pt->x));
+    r = max(r, absw(pt->y));
+    r = max(r, absw(pt->z));
+    pt++;
+  }
+
+  return r;
+}
+
+/* Far enough for div16 in ProjectObject3D and UpdateFaceVisibility. */
+short HostMeshDistance(Mesh3D *mesh) {
+  short r = min(HostMeshRadius(mesh), (short)10000);
+  return max((short)(3 * r), (short)fx4i(250));
+}
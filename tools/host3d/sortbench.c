@@ -0,0 +1,282 @@
+#include <string.h>
+#include <strings.h>
+#include <fx.h>
+#include "host.h"
+
+/*
+ * Compares RadixSortItemArray with SortItemArray built for the host. Both
+ * sorts are first checked to give the same order of keys, and the radix sort
+ * to be stable, on synthetic tables of various sizes and key ranges. Then
+ * both are timed on these tables and on depth keys of visible faces of
+ * rotating meshes, taken in face order, i.e. as a full sort would see them.
+ * SortFaces, which computes the keys and repairs the previous order, is timed
+ * for reference. As in bench3d only relative numbers matter.
+ */
+
+#define FRAMES 1000
+#define MAXSIZE 2048
+#define REPEAT 200
+
+static SortItemT input[MAXSIZE];
+static SortItemT radix[MAXSIZE];
+static SortItemT quick[MAXSIZE];
+static SortItemT temp[MAXSIZE];
+
+static u_int seed = 0xdeadc0de;
+
+static u_short Random(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+typedef enum {
+  NARROW,   /* within 256 consecutive values, single pass */
+  WIDE,     /* whole range of short, two passes */
+  EQUAL,
+  SORTED,
+  REVERSED,
+  KINDS
+} KindT;
+
+static const char *KindName[KINDS] = {
+  "narrow", "wide", "equal", "sorted", "reversed"
+};
+
+static void MakeTable(KindT kind, short n) {
+  short base = Random();
+  short i;
+
+  for (i = 0; i < n; i++) {
+    short key;
+
+    switch (kind) {
+      case NARROW:
+        key = base + (Random() & 255);
+        break;
+      case WIDE:
+        key = Random();
+        break;
+      case EQUAL:
+        key = base;
+        break;
+      case SORTED:
+        key = -n + i * 2;
+        break;
+      default:
+        key = n - i * 2;
+        break;
+    }
+
+    input[i].key = key;
+    input[i].index = i;
+  }
+}
+
+/* Radix sort must be stable and agree with quick sort on order of keys. */
+static bool Verify(const char *name, short n) {
+  short i;
+
+  for (i = 1; i < n; i++) {
+    if (radix[i - 1].key > radix[i].key) {
+      printf("%s: radix sort out of order at %d!\n", name, i);
+      return false;
+    }
+    if (radix[i - 1].key == radix[i].key &&
+        radix[i - 1].index > radix[i].index)
+    {
+      printf("%s: radix sort not stable at %d!\n", name, i);
+      return false;
+    }
+  }
+
+  for (i = 0; i < n; i++) {
+    if (radix[i].key != quick[i].key) {
+      printf("%s: sorts disagree at %d of %d!\n", name, i, n);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool Sort(const char *name, short n) {
+  memcpy(radix, input, sizeof(SortItemT) * n);
+  RadixSortItemArray(radix, temp, n);
+  memcpy(quick, input, sizeof(SortItemT) * n);
+  if (n > 0)
+    SortItemArray(quick, n);
+  return Verify(name, n);
+}
+
+static const short Sizes[] = {
+  1, 2, 3, 12, 13, 14, 31, 32, 33, 100, 300, 1000, MAXSIZE, 0
+};
+
+static bool CheckTables(void) {
+  const short *size;
+  short kind, k;
+
+  for (kind = 0; kind < KINDS; kind++)
+    for (size = Sizes; *size; size++)
+      for (k = 0; k < 20; k++) {
+        MakeTable(kind, *size);
+        if (!Sort(KindName[kind], *size))
+          return false;
+      }
+
+  return true;
+}
+
+/* Nanoseconds per sort of 'n' items made by MakeTable. */
+static void TimeTable(KindT kind, short n, u_long *radixTime,
+                      u_long *quickTime)
+{
+  short k;
+
+  *radixTime = 0;
+  *quickTime = 0;
+
+  for (k = 0; k < REPEAT; k++) {
+    u_long start;
+
+    MakeTable(kind, n);
+
+    memcpy(radix, input, sizeof(SortItemT) * n);
+    start = HostNanoTime();
+    RadixSortItemArray(radix, temp, n);
+    *radixTime += HostNanoTime() - start;
+
+    memcpy(quick, input, sizeof(SortItemT) * n);
+    start = HostNanoTime();
+    SortItemArray(quick, n);
+    *quickTime += HostNanoTime() - start;
+  }
+
+  *radixTime /= REPEAT;
+  *quickTime /= REPEAT;
+}
+
+static void BenchTables(void) {
+  const short *size;
+  short kind;
+
+  printf("%-10s %6s %12s %12s\n", "keys", "items", "radix ns", "quick ns");
+
+  for (kind = 0; kind < KINDS; kind++)
+    for (size = Sizes; *size; size++) {
+      u_long radixTime, quickTime;
+
+      if (*size < 32)
+        continue;
+
+      TimeTable(kind, *size, &radixTime, &quickTime);
+      printf("%-10s %6d %12lu %12lu\n",
+             KindName[kind], *size, radixTime, quickTime);
+    }
+}
+
+static bool BenchMesh(HostMeshT *entry, short frames) {
+  Object3D *object = NewObject3D(entry->mesh);
+  Mesh3D *mesh = entry->mesh;
+  u_long radixTime = 0, quickTime = 0, sortFacesTime = 0;
+  int visible = 0;
+  short frame;
+
+  for (frame = 0; frame < frames; frame++) {
+    short *depth = object->faceDepth;
+    u_long start;
+    short i, n;
+
+    object->rotate.x = frame * 8;
+    object->rotate.y = frame * 12;
+    object->rotate.z = frame * 4;
+    object->translate.x = 0;
+    object->translate.y = 0;
+    object->translate.z = -HostMeshDistance(mesh);
+
+    UpdateObjectTransformation(object);
+    UpdateFaceVisibility(object);
+    UpdateVertexVisibility(object);
+
+    start = HostNanoTime();
+    SortFaces(object);
+    sortFacesTime += HostNanoTime() - start;
+
+    for (i = 0, n = 0; i < mesh->faces; i++) {
+      if (depth[i] != NOFACE) {
+        input[n].key = depth[i];
+        input[n].index = i;
+        n++;
+      }
+    }
+
+    visible += n;
+
+    memcpy(radix, input, sizeof(SortItemT) * n);
+    start = HostNanoTime();
+    RadixSortItemArray(radix, temp, n);
+    radixTime += HostNanoTime() - start;
+
+    memcpy(quick, input, sizeof(SortItemT) * n);
+    start = HostNanoTime();
+    if (n > 0)
+      SortItemArray(quick, n);
+    quickTime += HostNanoTime() - start;
+
+    if (!Verify(entry->name, n)) {
+      DeleteObject3D(object);
+      return false;
+    }
+  }
+
+  printf("%-10s %6d %8d %12lu %12lu %12lu\n", entry->name, mesh->faces,
+         visible / frames, radixTime / frames, quickTime / frames,
+         sortFacesTime / frames);
+
+  DeleteObject3D(object);
+  return true;
+}
+
+static short ParseNumber(const char *s) {
+  short n = 0;
+  while (*s >= '0' && *s <= '9')
+    n = n * 10 + (*s++ - '0');
+  return n;
+}
+
+int main(int argc, char **argv) {
+  HostMeshT *entry;
+  short frames = FRAMES;
+  short i = 1;
+
+  if (i + 1 < argc && !strcmp(argv[i], "-n")) {
+    frames = max(ParseNumber(argv[i + 1]), (short)1);
+    i += 2;
+  }
+
+  if (!CheckTables())
+    return 1;
+
+  BenchTables();
+
+  printf("\n%-10s %6s %8s %12s %12s %12s\n", "mesh", "faces", "visible",
+         "radix ns", "quick ns", "SortFaces");
+
+  if (i == argc)
+    for (entry = HostMesh; entry->name; entry++)
+      if (!BenchMesh(entry, frames))
+        return 1;
+
+  for (; i < argc; i++) {
+    if (!(entry = LookupHostMesh(argv[i]))) {
+      printf("%s: no such mesh\n", argv[i]);
+      return 1;
+    }
+    if (!BenchMesh(entry, frames))
+      return 1;
+  }
+
+  return 0;
+}
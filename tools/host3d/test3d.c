@@ -0,0 +1,266 @@
+#include <string.h>
+#include <strings.h>
+#include <fx.h>
+#include "host.h"
+
+/*
+ * Runs an animation through the 3D pipeline and prints a hash of results of
+ * each stage. Output is compared against golden data by "make check". Hashes
+ * are calculated over words and bytes rather than memory contents, so they
+ * do not depend on endianness and can be reproduced on the Amiga.
+ *
+ * Pass -v to print hashes of each frame, which helps to find the first one
+ * that differs.
+ */
+
+#define FRAMES 256
+#define MAXPOLY 64
+
+typedef enum {
+  TRANSFORM,
+  VISIBILITY,
+  PROJECT,
+  SORT,
+  CLIP2D,
+  CAMERA,
+  CLIP3D,
+  STAGES
+} StageT;
+
+static const char *StageName[STAGES] = {
+  "transform", "visibility", "project", "sort", "clip2d", "camera", "clip3d"
+};
+
+static bool verbose = false;
+
+/* FNV-1a */
+static u_int HashBytes(u_int h, void *data, int n) {
+  u_char *p = data;
+  while (--n >= 0) {
+    h ^= *p++;
+    h *= 16777619;
+  }
+  return h;
+}
+
+static u_int HashWords(u_int h, void *data, int n) {
+  u_short *p = data;
+  while (--n >= 0) {
+    u_short w = *p++;
+    h = (h ^ (w >> 8)) * 16777619;
+    h = (h ^ (w & 255)) * 16777619;
+  }
+  return h;
+}
+
+static u_int HashItems(u_int h, SortItemT *item, short n) {
+  while (--n >= 0) {
+    h = HashWords(h, &item->key, 1);
+    h = HashWords(h, &item->index, 1);
+    item++;
+  }
+  return h;
+}
+
+static u_int HashMatrix(u_int h, Matrix3D *m) {
+  return HashWords(h, m, sizeof(Matrix3D) / sizeof(short));
+}
+
+static u_int HashPoints3D(u_int h, Point3D *pt, short n) {
+  while (--n >= 0) {
+    h = HashWords(h, pt++, 3);
+  }
+  return h;
+}
+
+/* Object rotates in front of the camera at safe distance. */
+static void Visible(Object3D *object, short frame, u_int *hash) {
+  Mesh3D *mesh = object->mesh;
+
+  object->rotate.x = frame * 8;
+  object->rotate.y = frame * 12;
+  object->rotate.z = frame * 4;
+  object->translate.x = 0;
+  object->translate.y = 0;
+  object->translate.z = -HostMeshDistance(mesh);
+
+  UpdateObjectTransformation(object);
+  hash[TRANSFORM] = HashMatrix(hash[TRANSFORM], &object->objectToWorld);
+  hash[TRANSFORM] = HashMatrix(hash[TRANSFORM], &object->worldToObject);
+  hash[TRANSFORM] = HashWords(hash[TRANSFORM], &object->camera, 3);
+
+  UpdateFaceVisibility(object);
+  hash[VISIBILITY] = HashBytes(hash[VISIBILITY], object->faceFlags,
+                               mesh->faces);
+  UpdateVertexVisibility(object);
+  hash[VISIBILITY] = HashBytes(hash[VISIBILITY], object->vertexFlags,
+                               mesh->vertices);
+  if (mesh->edges) {
+    UpdateEdgeVisibility(object);
+    hash[VISIBILITY] = HashBytes(hash[VISIBILITY], object->edgeFlags,
+                                 mesh->edges);
+  }
+
+  /* Projected vertices are set only for visible faces. */
+  bzero(object->vertex, sizeof(Point3D) * mesh->vertices);
+  ProjectObject3D(object, 160, 128);
+  hash[PROJECT] = HashPoints3D(hash[PROJECT], object->vertex, mesh->vertices);
+  hash[PROJECT] = HashBytes(hash[PROJECT], object->faceFlags, mesh->faces);
+  hash[PROJECT] = HashWords(hash[PROJECT], object->faceDepth, mesh->faces);
+
+  OrderFaces(object);
+  hash[SORT] = HashItems(hash[SORT], object->visibleFace,
+                         object->visibleFaces);
+
+  /* Also sort from scratch, as effects without ProjectObject3D do. */
+  SortFaces(object);
+  hash[SORT] = HashItems(hash[SORT], object->visibleFace,
+                         object->visibleFaces);
+  {
+    static SortItemT item[SCENE_FACE_MASK + 1];
+    static SortItemT temp[SCENE_FACE_MASK + 1];
+    short n = object->visibleFaces;
+
+    memcpy(item, object->visibleFace, sizeof(SortItemT) * n);
+    RadixSortItemArray(item, temp, n);
+    hash[SORT] = HashItems(hash[SORT], item, n);
+
+    memcpy(item, object->visibleFace, sizeof(SortItemT) * n);
+    if (n > 0)
+      SortItemArray(item, n);
+    hash[SORT] = HashItems(hash[SORT], item, n);
+  }
+}
+
+/* Clips projected faces against window smaller than the object. */
+static void Clip2D(Object3D *object, u_int *hash) {
+  static Point2D point[MAXPOLY];
+  static Point2D buffer[MAXPOLY];
+  static u_char flags[MAXPOLY];
+  IndexListT **faces = object->mesh->face;
+  char *faceFlags = object->faceFlags;
+  Point3D *vertex = object->vertex;
+  short n = object->mesh->faces;
+
+  ClipWin.minX = 140;
+  ClipWin.minY = 108;
+  ClipWin.maxX = 180;
+  ClipWin.maxY = 148;
+
+  while (--n >= 0) {
+    IndexListT *face = *faces++;
+    short count = face->count;
+    u_char clipFlags = 0;
+    u_char outside = 0xff;
+    short i;
+
+    if (*faceFlags++ < 0)
+      continue;
+
+    for (i = 0; i < count; i++) {
+      Point3D *pt = &vertex[face->indices[i]];
+      point[i].x = pt->x;
+      point[i].y = pt->y;
+    }
+    point[count] = point[0];
+
+    PointsInsideBox(point, flags, count);
+    for (i = 0; i < count; i++) {
+      clipFlags |= flags[i];
+      outside &= flags[i];
+    }
+
+    if (!outside) {
+      Point2D *out = buffer;
+      short m = ClipPolygon2D(point, &out, count + 1, clipFlags);
+      hash[CLIP2D] = HashWords(hash[CLIP2D], out, m * 2);
+    }
+  }
+}
+
+/* Object moves across the frustum and its faces get clipped. */
+static void Crossing(Object3D *object, short frame, u_int *hash) {
+  Mesh3D *mesh = object->mesh;
+  short r = min(HostMeshRadius(mesh), (short)8000);
+  short a = frame * 24;
+  short n;
+
+  ClipFrustum.near = -r / 2;
+  ClipFrustum.far = -3 * r;
+
+  object->rotate.x = frame * 4;
+  object->rotate.y = frame * 8;
+  object->rotate.z = frame * 12;
+  object->translate.x = normfx(SIN(a) * (short)(2 * r));
+  object->translate.y = normfx(COS(a * 3) * r);
+  object->translate.z = -3 * r / 2 + normfx(COS(a) * (short)(3 * r / 2));
+
+  UpdateObjectTransformation(object);
+  Transform3D(&object->objectToWorld, object->vertex, mesh->vertex,
+              mesh->vertices);
+  hash[CAMERA] = HashPoints3D(hash[CAMERA], object->vertex, mesh->vertices);
+
+  hash[CLIP3D] = HashWords(hash[CLIP3D], &ClipFrustum, 2);
+  if (UpdateClipFlags(object)) {
+    hash[CLIP3D] = HashBytes(hash[CLIP3D], object->vertexFlags,
+                             mesh->vertices);
+    for (n = 0; n < mesh->faces; n++) {
+      Point3D *out;
+      short m = ClipFace3D(object, n, &out);
+      hash[CLIP3D] = HashWords(hash[CLIP3D], &m, 1);
+      if (m > 0)
+        hash[CLIP3D] = HashPoints3D(hash[CLIP3D], out, m);
+    }
+  }
+}
+
+static void TestMesh(HostMeshT *entry) {
+  Object3D *object = NewObject3D(entry->mesh);
+  u_int hash[STAGES];
+  short frame, i;
+
+  for (i = 0; i < STAGES; i++)
+    hash[i] = 2166136261U;
+
+  for (frame = 0; frame < FRAMES; frame++) {
+    Visible(object, frame, hash);
+    Clip2D(object, hash);
+    Crossing(object, frame, hash);
+
+    if (verbose) {
+      printf("%s %d", entry->name, frame);
+      for (i = 0; i < STAGES; i++)
+        printf(" %08x", hash[i]);
+      printf("\n");
+    }
+  }
+
+  for (i = 0; i < STAGES; i++)
+    printf("%s %s %08x\n", entry->name, StageName[i], hash[i]);
+
+  DeleteObject3D(object);
+}
+
+int main(int argc, char **argv) {
+  HostMeshT *entry;
+  short i = 1;
+
+  if (i < argc && !strcmp(argv[i], "-v")) {
+    verbose = true;
+    i++;
+  }
+
+  if (i == argc)
+    for (entry = HostMesh; entry->name; entry++)
+      TestMesh(entry);
+
+  for (; i < argc; i++) {
+    if (!(entry = LookupHostMesh(argv[i]))) {
+      printf("%s: no such mesh\n", argv[i]);
+      return 1;
+    }
+    TestMesh(entry);
+  }
+
+  return 0;
+}
@@ -0,0 +1,390 @@
+#include <c2p.h>
+
+/*
+ * Checks chunky to planar layouts of libblit bit by bit and estimates what
+ * they cost. Random pixels are encoded into chunky format of each layout and
+ * converted in three ways:
+ *
+ *  - by a model of the blitter that shifts bits in from neighbouring words,
+ *    runs left shifts in descending mode and splits tall passes exactly as
+ *    C2PSetBuffers does, with garbage in the shifter when each blit starts,
+ *  - by C2PLayoutConvert, i.e. what the CPU does in split mode,
+ *  - by reference conversion that works on single pixels.
+ *
+ * All three must give the same bitplanes. Costs are given in DMA slots, i.e.
+ * memory cycles of 280ns, assuming the blitter does not compete for them.
+ */
+
+/* Provided by the C library of the host. */
+int printf(const char *format, ...) __attribute__ ((format (printf, 1, 2)));
+int strcmp(const char *s1, const char *s2);
+
+/* Same as BLIT_MAXROWS, which comes with headers of the Amiga side. */
+#define MAXROWS 1024
+
+/* Slots in a PAL frame, i.e. 313 lines of 227 slots. */
+#define FRAME_SLOTS (313 * 227)
+
+#define MAXWORDS 20480 /* 320x256 pixels of 1x1x4 layout */
+
+static u_short pixel[MAXWORDS * 4];
+static u_short chunky[MAXWORDS];
+static u_short temp[MAXWORDS];
+static u_short output[C2P_MAXOUTPUTS][MAXWORDS];
+static u_short expected[C2P_MAXOUTPUTS][MAXWORDS];
+
+static u_int seed = 0xdeadc0de;
+
+static u_short Random(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+/*
+ * Reference conversion. Bit b of a pixel goes to plane b, pixels are placed
+ * from the most significant bit of the first word on. 2x1 layouts put each
+ * pixel twice.
+ */
+static void Planar(u_short (*plane)[MAXWORDS], int pixels, short width) {
+  int i;
+  short b, k;
+
+  for (b = 0; b < 4; b++)
+    for (i = 0; i < pixels * width / 16; i++)
+      plane[b][i] = 0;
+
+  for (i = 0; i < pixels; i++)
+    for (k = 0; k < width; k++) {
+      int x = i * width + k;
+      for (b = 0; b < 4; b++)
+        if (pixel[i] & (1 << b))
+          plane[b][x >> 4] |= 0x8000 >> (x & 15);
+    }
+}
+
+/* Bits of a pixel as a string of bits of a word, most significant first. */
+typedef struct {
+  char pixel;
+  char bit;
+} BitT;
+
+static u_short Encode(const BitT *format, const u_short *pixels) {
+  u_short word = 0;
+  short i;
+
+  for (i = 0; i < 16; i++)
+    if (pixels[(short)format[i].pixel] & (1 << format[i].bit))
+      word |= 0x8000 >> i;
+
+  return word;
+}
+
+static const BitT Packed[16] = {
+  {0, 3}, {0, 2}, {0, 1}, {0, 0}, {1, 3}, {1, 2}, {1, 1}, {1, 0},
+  {2, 3}, {2, 2}, {2, 1}, {2, 0}, {3, 3}, {3, 2}, {3, 1}, {3, 0},
+};
+
+static const BitT Mangled1x1[16] = {
+  {0, 3}, {1, 3}, {0, 1}, {1, 1}, {0, 2}, {1, 2}, {0, 0}, {1, 0},
+  {2, 3}, {3, 3}, {2, 1}, {3, 1}, {2, 2}, {3, 2}, {2, 0}, {3, 0},
+};
+
+/* Pixels stand for HAM pixels that modify red, green, blue and blue. */
+static const BitT MangledHam6[16] = {
+  {0, 3}, {1, 3}, {2, 3}, {3, 3}, {0, 2}, {1, 2}, {2, 2}, {3, 2},
+  {0, 1}, {1, 1}, {2, 1}, {3, 1}, {0, 0}, {1, 0}, {2, 0}, {3, 0},
+};
+
+static const BitT Mangled2x1[16] = {
+  {0, 3}, {0, 2}, {1, 3}, {1, 2}, {0, 1}, {0, 0}, {1, 1}, {1, 0},
+  {2, 3}, {2, 2}, {3, 3}, {3, 2}, {2, 1}, {2, 0}, {3, 1}, {3, 0},
+};
+
+typedef struct {
+  const C2PLayoutT *layout;
+  const BitT *format;
+  short width;   /* of each chunky pixel on the screen */
+  bool swapped;  /* second and third byte of long words are swapped */
+  bool halves;   /* output i holds plane i and i + 2 one after another */
+} TestT;
+
+static TestT Tests[] = {
+  { &C2PLayout1x1x4, Packed, 1, false, false },
+  { &C2PLayout1x1x4Mangled, Mangled1x1, 1, false, false },
+  { &C2PLayout1x1Ham6Mangled, MangledHam6, 1, false, false },
+  { &C2PLayout2x1x4Mangled, Mangled2x1, 2, false, false },
+  { &C2PLayout2x1x4MangledFast, Mangled2x1, 2, true, true },
+  { NULL, NULL, 0, false, false },
+};
+
+static void MakePixels(TestT *test, int words) {
+  int i;
+
+  for (i = 0; i < words * 4; i++)
+    pixel[i] = Random() & 15;
+
+  /* Blue is used twice, see MangledHam6. */
+  if (test->format == MangledHam6)
+    for (i = 0; i < words * 4; i += 4)
+      pixel[i + 3] = pixel[i + 2];
+}
+
+/* Chunky buffer gets clobbered by conversion, so it is made for each one. */
+static void MakeChunky(TestT *test, int words) {
+  int i;
+
+  for (i = 0; i < words; i++)
+    chunky[i] = Encode(test->format, &pixel[i * 4]);
+
+  /* Long words are [b0 b1 b2 b3], so bytes swapped between the words. */
+  if (test->swapped)
+    for (i = 0; i < words; i += 2) {
+      u_short w0 = chunky[i];
+      u_short w1 = chunky[i + 1];
+      chunky[i] = (w0 & 0xff00) | (w1 >> 8);
+      chunky[i + 1] = (w0 << 8) | (w1 & 0x00ff);
+    }
+}
+
+static bool Verify(TestT *test, int words, const char *how) {
+  const C2PLayoutT *layout = test->layout;
+  int size = words * layout->size / 4;
+  short p;
+
+  for (p = 0; p < 4; p++) {
+    short o = test->halves ? (p & 1) : p;
+    int offset = test->halves ? (p >> 1) * (size / 2) : 0;
+    int n = test->halves ? size / 2 : size;
+    int i;
+
+    for (i = 0; i < n; i++) {
+      u_short got = output[o][offset + i];
+      if (got != expected[p][i]) {
+        printf("%s: %s: %d words: plane %d, word %d: got %04x, "
+               "expected %04x\n", layout->name, how, words, p, i, got,
+               expected[p][i]);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+static u_short *Buffer(u_char buf) {
+  if (buf == C2P_CHUNKY)
+    return chunky;
+  if (buf == C2P_TEMP)
+    return temp;
+  return output[buf - C2P_OUTPUT(0)];
+}
+
+static int BufferSize(const C2PLayoutT *layout, u_char buf, int words) {
+  return (buf >= C2P_OUTPUT(0)) ? words * layout->size / 4 : words;
+}
+
+typedef struct {
+  u_short *data;
+  int pos, size;
+  short modulo;
+  u_short old;
+} ChannelT;
+
+static void ChannelInit(ChannelT *ch, const C2PLayoutT *layout,
+                        const C2PPassT *pass, const C2PChannelT *channel,
+                        int words)
+{
+  if (channel->buf == C2P_NONE) {
+    ch->data = NULL;
+    return;
+  }
+
+  ch->data = Buffer(channel->buf);
+  ch->size = BufferSize(layout, channel->buf, words);
+  ch->pos = C2PChannelOffset(pass, channel, words);
+  ch->modulo = pass->left ? -channel->modulo : channel->modulo;
+}
+
+static inline bool ChannelInside(ChannelT *ch) {
+  return (!ch->data || (ch->pos >= 0 && ch->pos < ch->size)) ? true : false;
+}
+
+/*
+ * Blitter keeps previous word of channel A and B. In ascending mode shifted
+ * word takes low bits of the previous one, in descending mode high bits of
+ * the previous one are shifted in from the right.
+ */
+static u_short ChannelRead(ChannelT *ch, short shift, bool left, short step) {
+  u_short word, shifted;
+
+  if (!ch->data)
+    return 0;
+
+  word = ch->data[ch->pos];
+  ch->pos += step;
+
+  if (shift == 0)
+    shifted = word;
+  else if (left)
+    shifted = (word << shift) | (ch->old >> (16 - shift));
+  else
+    shifted = (word >> shift) | (ch->old << (16 - shift));
+
+  ch->old = word;
+  return shifted;
+}
+
+static bool Blit(const C2PLayoutT *layout, const C2PPassT *pass, int words) {
+  ChannelT a, b, d;
+  short step = pass->left ? -1 : 1;
+  int rows = C2PRows(pass, words);
+
+  ChannelInit(&a, layout, pass, &pass->a, words);
+  ChannelInit(&b, layout, pass, &pass->b, words);
+  ChannelInit(&d, layout, pass, &pass->d, words);
+
+  while (rows > 0) {
+    int n = (rows > MAXROWS) ? MAXROWS : rows;
+
+    /* Whatever previous blit has left in the shifter. */
+    a.old = Random();
+    b.old = Random();
+
+    rows -= n;
+
+    while (--n >= 0) {
+      short w;
+
+      for (w = 0; w < pass->width; w++) {
+        u_short x, y;
+
+        if (!ChannelInside(&a) || !ChannelInside(&b) || !ChannelInside(&d)) {
+          printf("%s: blit runs out of buffer!\n", layout->name);
+          return false;
+        }
+
+        x = ChannelRead(&a, pass->ashift, pass->left, step);
+        y = ChannelRead(&b, pass->bshift, pass->left, step);
+
+        d.data[d.pos] = (x & pass->mask) | (y & ~pass->mask);
+        d.pos += step;
+      }
+
+      a.pos += a.modulo;
+      b.pos += b.modulo;
+      d.pos += d.modulo;
+    }
+  }
+
+  return true;
+}
+
+typedef struct {
+  int blits;
+  int words;
+  int slots;
+} CostT;
+
+/* DMA slots per word taken by channels A, B and D or just A and D. */
+static CostT PassCost(const C2PPassT *pass, int words) {
+  int rows = C2PRows(pass, words);
+  CostT cost;
+
+  cost.blits = (rows + MAXROWS - 1) / MAXROWS;
+  cost.words = rows * pass->width;
+  cost.slots = cost.words * ((pass->b.buf == C2P_NONE) ? 2 : 3);
+  return cost;
+}
+
+static bool Check(TestT *test, int words, bool verbose) {
+  const C2PLayoutT *layout = test->layout;
+  u_short *out[C2P_MAXOUTPUTS];
+  CostT total = { 0, 0, 0 };
+  short i;
+
+  for (i = 0; i < C2P_MAXOUTPUTS; i++)
+    out[i] = output[i];
+
+  MakePixels(test, words);
+  MakeChunky(test, words);
+  Planar(expected, words * 4, test->width);
+
+  if (verbose)
+    printf("%s: %d words\n", layout->name, words);
+
+  for (i = 0; i < layout->passes; i++) {
+    const C2PPassT *pass = &layout->pass[i];
+    CostT cost = PassCost(pass, words);
+
+    if (!Blit(layout, pass, words))
+      return false;
+
+    total.blits += cost.blits;
+    total.words += cost.words;
+    total.slots += cost.slots;
+
+    if (verbose)
+      printf("  pass %d: %2d blits %6d words %7d slots\n", i, cost.blits,
+             cost.words, cost.slots);
+  }
+
+  if (verbose)
+    printf("  total:  %2d blits %6d words %7d slots (%d%% of frame)\n",
+           total.blits, total.words, total.slots,
+           total.slots * 100 / FRAME_SLOTS);
+
+  if (!Verify(test, words, "blitter"))
+    return false;
+
+  MakeChunky(test, words);
+  C2PLayoutConvert(layout, chunky, temp, out, words);
+
+  return Verify(test, words, "cpu");
+}
+
+/* Small buffer, uvmap size and full screen with passes split in few blits. */
+static const int Sizes[] = { 16, 4000, MAXWORDS, 0 };
+
+static bool CheckLayout(TestT *test) {
+  const int *words;
+
+  for (words = Sizes; *words; words++)
+    if (!Check(test, *words, (*words == 4000) ? true : false))
+      return false;
+
+  printf("%s: ok\n", test->layout->name);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  TestT *test;
+  bool ok = true;
+  int i;
+
+  /* Every layout must be covered by a test. */
+  for (i = 0; C2PLayouts[i]; i++) {
+    for (test = Tests; test->layout; test++)
+      if (test->layout == C2PLayouts[i])
+        break;
+    if (!test->layout) {
+      printf("%s: no test!\n", C2PLayouts[i]->name);
+      ok = false;
+    }
+  }
+
+  for (test = Tests; test->layout; test++) {
+    if (argc > 1) {
+      for (i = 1; i < argc; i++)
+        if (!strcmp(argv[i], test->layout->name))
+          break;
+      if (i == argc)
+        continue;
+    }
+    if (!CheckLayout(test))
+      ok = false;
+  }
+
+  return ok ? 0 : 1;
+}
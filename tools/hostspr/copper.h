@@ -0,0 +1,23 @@
+#ifndef __COPPER_H__
+#define __COPPER_H__
+
+#include <gfx.h>
+
+/*
+ * Stands in for copper.h of the demo system, which relies on casts used as
+ * lvalues that compilers of the host reject. It is forced in before other
+ * headers, so its include guard hides the real one. Instructions hold whole
+ * host pointers, so that tests can follow what was put into them.
+ */
+
+typedef struct {
+  void *data;
+} CopInsT;
+
+typedef struct CopList CopListT;
+
+static inline void CopInsSet32(CopInsT *ins, void *data) {
+  ins->data = data;
+}
+
+#endif
@@ -0,0 +1,357 @@
+#include <sprite.h>
+
+/*
+ * Checks SpriteMuxBuild by walking data it made for each DMA channel, just as
+ * the hardware would do. Every long word of pixel data of a sprite is tagged
+ * with number of the sprite and line, so that each sprite shown on screen can
+ * be told apart and matched with its position and attachment.
+ *
+ * A few scenes check single and pair channel selection, lines that have to be
+ * left empty between sprites and running out of space in a buffer. Random
+ * scenes check only that the result is consistent.
+ */
+
+/* Provided by the C library of the host. */
+int printf(const char *format, ...) __attribute__ ((format (printf, 1, 2)));
+
+#define CHANNELS 8
+#define MAXSPRITES 256
+#define MAXHEIGHT 32
+
+static u_int spriteData[MAXSPRITES][1 + MAXHEIGHT];
+static SpriteT sprites[MAXSPRITES];
+static MuxSpriteT scene[MAXSPRITES];
+static short shown[MAXSPRITES];
+
+static CopInsT ins[CHANNELS];
+static CopInsT *sprptr[CHANNELS] = {
+  &ins[0], &ins[1], &ins[2], &ins[3], &ins[4], &ins[5], &ins[6], &ins[7]
+};
+
+static u_int seed = 0xdeadc0de;
+
+static u_short Random(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+#define TAG(s, l) (((u_int)(s) << 16) | (l))
+
+/* Sprite 'i' has 'height' lines and pixel data tagged with its number. */
+static SpriteT *MakeTestSprite(short i, short height) {
+  SpriteT *spr = &sprites[i];
+  u_int *data = spriteData[i];
+  short l;
+
+  /* Control words are skipped by the muxer. */
+  data[0] = 0xffffffff;
+  for (l = 0; l < height; l++)
+    data[1 + l] = TAG(i, l);
+
+  spr->sprdat = (SprDataT *)data;
+  spr->height = height;
+  spr->attached = false;
+  return spr;
+}
+
+static short n;
+
+static void Clear(void) {
+  n = 0;
+}
+
+static void AddSingle(short x, short y, short height) {
+  scene[n].sprite[0] = MakeTestSprite(n, height);
+  scene[n].sprite[1] = NULL;
+  scene[n].x = x;
+  scene[n].y = y;
+  n++;
+}
+
+/* Second sprite of a pair is stored under next number, but never shown. */
+static void AddPair(short x, short y, short height) {
+  scene[n].sprite[0] = MakeTestSprite(n, height);
+  scene[n].sprite[1] = MakeTestSprite(n + 1, height);
+  scene[n].x = x;
+  scene[n].y = y;
+  scene[n + 1].sprite[0] = NULL;
+  n += 2;
+}
+
+static bool Fail(const char *name, const char *what, short ch) {
+  printf("%s: channel %d: %s!\n", name, ch, what);
+  return false;
+}
+
+/*
+ * Walks data of all channels. Each sprite must be shown once where it was
+ * placed, with all lines of its data. Sprites on a channel must be at least
+ * one line apart. Pairs take channels 2k and 2k+1, the latter with attach bit.
+ * Number of shown sprites, not counting second ones of pairs, goes to 'total'.
+ */
+static bool Walk(const char *name, short *total) {
+  short ch, i;
+
+  *total = 0;
+
+  for (i = 0; i < n; i++)
+    shown[i] = -1;
+
+  for (ch = 0; ch < CHANNELS; ch++) {
+    u_int *data = ins[ch].data;
+    short vfree = 0;
+
+    while (*data) {
+      u_short pos = *data >> 16;
+      u_short ctl = *data++;
+      short vstart = (pos >> 8) | ((ctl & 4) << 6);
+      short vstop = (ctl >> 8) | ((ctl & 2) << 7);
+      short x = ((pos & 255) << 1) | (ctl & 1);
+      bool attached = (ctl & 0x80) ? true : false;
+      short height = vstop - vstart;
+      short s = *data >> 16;
+      short owner = attached ? s - 1 : s;
+      MuxSpriteT *mspr;
+      short l;
+
+      if (s < 0 || s >= n || owner < 0)
+        return Fail(name, "unknown sprite", ch);
+      if (vstart < vfree)
+        return Fail(name, "sprites too close", ch);
+      if (height <= 0)
+        return Fail(name, "empty sprite", ch);
+
+      mspr = &scene[owner];
+
+      if (mspr->x != x || mspr->y != vstart)
+        return Fail(name, "wrong position", ch);
+      if (mspr->sprite[0]->height != height)
+        return Fail(name, "wrong height", ch);
+      if (attached != ((mspr->sprite[1] && s != owner) ? true : false))
+        return Fail(name, "wrong attach bit", ch);
+      if (mspr->sprite[1] && (ch & 1) != (s - owner))
+        return Fail(name, "pair not on channels 2k and 2k+1", ch);
+      if (shown[s] >= 0)
+        return Fail(name, "sprite shown twice", ch);
+
+      for (l = 0; l < height; l++)
+        if (*data++ != TAG(s, l))
+          return Fail(name, "wrong pixel data", ch);
+
+      shown[s] = ch;
+      vfree = vstop + 1;
+      if (s == owner)
+        (*total)++;
+    }
+  }
+
+  for (i = 0; i < n; i++) {
+    MuxSpriteT *mspr = &scene[i];
+    if (mspr->sprite[0] && mspr->sprite[1]) {
+      if ((shown[i] < 0) != (shown[i + 1] < 0))
+        return Fail(name, "half of a pair shown", shown[i]);
+      if (shown[i] >= 0 && shown[i + 1] != shown[i] + 1)
+        return Fail(name, "halves of a pair apart", shown[i]);
+    }
+  }
+
+  return true;
+}
+
+/* Builds the scene and checks that 'dropped' sprites were left out. */
+static bool Check(SpriteMuxT *mux, const char *name, short dropped) {
+  MuxSpriteT list[MAXSPRITES];
+  short count = 0;
+  short i, result, total;
+
+  /* Second sprites of pairs do not get entries of their own. */
+  for (i = 0; i < n; i++)
+    if (scene[i].sprite[0])
+      list[count++] = scene[i];
+
+  result = SpriteMuxBuild(mux, list, count, sprptr);
+
+  if (!Walk(name, &total))
+    return false;
+
+  if (total + result != count) {
+    printf("%s: %d shown, but %d of %d dropped!\n",
+           name, total, result, count);
+    return false;
+  }
+
+  if (dropped >= 0 && result != dropped) {
+    printf("%s: %d dropped, expected %d!\n", name, result, dropped);
+    return false;
+  }
+
+  if (dropped >= 0)
+    printf("%s: %d shown, %d dropped\n", name, total, result);
+  return true;
+}
+
+/* Single sprites take channels whose pair is in use, so pairs still fit. */
+static bool TestPairsStayFree(SpriteMuxT *mux) {
+  short i;
+
+  Clear();
+  for (i = 0; i < 4; i++)
+    AddSingle(0x80 + i * 16, 0x40, 8);
+  AddPair(0x100, 0x40, 8);
+  AddPair(0x120, 0x40, 8);
+  if (!Check(mux, "pairs stay free", 0))
+    return false;
+
+  /*
+   * At line 0x50 channels 0 and 1 are free again and channel 2 is still busy.
+   * Single sprite must go to channel 3, even though channel 0 got free later.
+   */
+  Clear();
+  AddPair(0x80, 0x40, 4);
+  AddSingle(0x90, 0x40, 30);
+  AddSingle(0xa0, 0x50, 8);
+  for (i = 0; i < 3; i++)
+    AddPair(0xb0 + i * 16, 0x50, 8);
+  return Check(mux, "single next to busy channel", 0);
+}
+
+static bool TestOneLine(SpriteMuxT *mux) {
+  short i;
+
+  Clear();
+  for (i = 0; i < 9; i++)
+    AddSingle(0x80 + i * 16, 0x40, 8);
+  if (!Check(mux, "nine singles on a line", 1))
+    return false;
+
+  Clear();
+  for (i = 0; i < 5; i++)
+    AddPair(0x80 + i * 16, 0x40, 8);
+  return Check(mux, "five pairs on a line", 1);
+}
+
+/* Hardware needs a line between sprites to fetch control words. */
+static bool TestReuse(SpriteMuxT *mux) {
+  short i;
+
+  Clear();
+  for (i = 0; i < 8; i++)
+    AddSingle(0x80 + i * 16, 0x40, 10);
+  for (i = 0; i < 8; i++)
+    AddSingle(0x80 + i * 16, 0x4b, 10);
+  if (!Check(mux, "sprites one line apart", 0))
+    return false;
+
+  Clear();
+  for (i = 0; i < 8; i++)
+    AddSingle(0x80 + i * 16, 0x40, 10);
+  for (i = 0; i < 8; i++)
+    AddSingle(0x80 + i * 16, 0x4a, 10);
+  return Check(mux, "sprites with no line apart", 8);
+}
+
+/* Sprites must cross 256th line of the display properly. */
+static bool TestHighBits(SpriteMuxT *mux) {
+  Clear();
+  AddSingle(0x81, 0xfc, 8);
+  AddPair(0x1c1, 0x100, 20);
+  AddSingle(0x1c1, 0x105, 8);
+  return Check(mux, "sprites around line 256", 0);
+}
+
+/*
+ * Buffer of a channel made for 32 lines holds 49 long words. Sprite of 15
+ * lines takes 16, so three of them fit and one long word is left for the
+ * terminator.
+ */
+static bool TestCapacity(void) {
+  SpriteMuxT *mux = NewSpriteMux(MAXSPRITES, 32);
+  bool ok;
+  short i;
+
+  Clear();
+  for (i = 0; i < 40; i++)
+    AddSingle(0x80 + (i & 7) * 16, 0x30 + (i >> 3) * 16, 15);
+  ok = Check(mux, "buffer overflow", 16);
+
+  DeleteSpriteMux(mux);
+  return ok;
+}
+
+/* Next frame goes to another buffer, so the one being displayed is intact. */
+static bool TestDoubleBuffer(SpriteMuxT *mux) {
+  void *first[CHANNELS];
+  short i;
+
+  Clear();
+  AddSingle(0x80, 0x40, 8);
+  if (!Check(mux, "first frame", 0))
+    return false;
+
+  for (i = 0; i < CHANNELS; i++)
+    first[i] = ins[i].data;
+
+  AddSingle(0x90, 0x60, 8);
+  if (!Check(mux, "second frame", 0))
+    return false;
+
+  for (i = 0; i < CHANNELS; i++) {
+    if (ins[i].data == first[i])
+      return Fail("second frame", "buffer reused", i);
+    if (*(u_int *)first[i] && ((u_int *)first[i])[1] != TAG(0, 0))
+      return Fail("second frame", "previous frame overwritten", i);
+  }
+
+  return true;
+}
+
+static bool TestRandom(SpriteMuxT *mux) {
+  short k;
+
+  for (k = 0; k < 100; k++) {
+    Clear();
+
+    while (n < 120) {
+      short x = 0x80 + Random() % 320;
+      short y = 0x2c + Random() % 256;
+      short height = 1 + Random() % MAXHEIGHT;
+
+      if (Random() & 3)
+        AddSingle(x, y, height);
+      else
+        AddPair(x, y, height);
+    }
+
+    if (!Check(mux, "random scene", -1))
+      return false;
+  }
+
+  printf("random scenes: %d consistent\n", k);
+  return true;
+}
+
+int main(void) {
+  SpriteMuxT *mux = NewSpriteMux(MAXSPRITES, 312);
+  bool ok = true;
+
+  if (!TestPairsStayFree(mux))
+    ok = false;
+  if (!TestOneLine(mux))
+    ok = false;
+  if (!TestReuse(mux))
+    ok = false;
+  if (!TestHighBits(mux))
+    ok = false;
+  if (!TestCapacity())
+    ok = false;
+  if (!TestDoubleBuffer(mux))
+    ok = false;
+  if (!TestRandom(mux))
+    ok = false;
+
+  DeleteSpriteMux(mux);
+
+  return ok ? 0 : 1;
+}
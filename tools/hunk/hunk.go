@@ -29,6 +29,8 @@ const (
 	HUNK_RELOC32SHORT          = 1020
 	HUNK_RELRELOC32            = 1021
 	HUNK_ABSRELOC16            = 1022
+	/* Not an AmigaOS hunk type. Understood only by our trackmo loader. */
+	HUNK_LZ4 = 1100
 )
 
 type ExtType uint8
@@ -96,6 +98,7 @@ func init() {
 		HUNK_RELOC32SHORT: "HUNK_RELOC32SHORT",
 		HUNK_RELRELOC32:   "HUNK_RELRELOC32",
 		HUNK_ABSRELOC16:   "HUNK_ABSRELOC16",
+		HUNK_LZ4:          "HUNK_LZ4",
 	}
 
 	HunkExtNameMap = map[ExtType]string{
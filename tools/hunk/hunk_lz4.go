@@ -0,0 +1,31 @@
+package hunk
+
+import (
+	"fmt"
+	"io"
+)
+
+/*
+ * HUNK_CODE or HUNK_DATA compressed with LZ4 by tools/hunkpack.
+ * Stream format is described in lib/libmisc/lz4unpack.S.
+ */
+type HunkLz4 struct {
+	Packed HunkType
+	Size   uint32
+	Bytes  []byte
+}
+
+func readHunkLz4(r io.Reader) HunkLz4 {
+	packed := HunkType(readLong(r))
+	size := readLong(r) * 4
+	return HunkLz4{packed, size, readData(r, readLong(r)*4)}
+}
+
+func (h HunkLz4) Type() HunkType {
+	return HUNK_LZ4
+}
+
+func (h HunkLz4) String() string {
+	return fmt.Sprintf("%s [%s, %d bytes packed to %d bytes]\n",
+		HunkNameMap[h.Type()], HunkNameMap[h.Packed], h.Size, len(h.Bytes))
+}
@@ -107,6 +107,8 @@ func ReadFile(path string) (hunks []Hunk, err error) {
 			hunk = readHunkData(file)
 		case HUNK_BSS:
 			hunk = readHunkBss(file)
+		case HUNK_LZ4:
+			hunk = readHunkLz4(file)
 		case HUNK_RELOC32:
 			hunk = readHunkReloc32(file)
 		case HUNK_SYMBOL:
@@ -0,0 +1,99 @@
+package hunk
+
+import (
+	"bufio"
+	"encoding/binary"
+	"fmt"
+	"io"
+	"os"
+)
+
+func writeLong(w io.Writer, x uint32) {
+	if binary.Write(w, binary.BigEndian, x) != nil {
+		panic("write failed")
+	}
+}
+
+func writeData(w io.Writer, data []byte) {
+	if _, err := w.Write(data); err != nil {
+		panic("write failed")
+	}
+	if pad := (4 - len(data)%4) % 4; pad > 0 {
+		w.Write(make([]byte, pad))
+	}
+}
+
+func (h HunkHeader) Write(w io.Writer) {
+	writeLong(w, HUNK_HEADER)
+	for _, s := range h.Residents {
+		if s == "" {
+			continue
+		}
+		writeLong(w, uint32((len(s)+3)/4))
+		writeData(w, []byte(s))
+	}
+	writeLong(w, 0)
+	writeLong(w, h.Hunks)
+	writeLong(w, h.First)
+	writeLong(w, h.Last)
+	for _, v := range h.Specifiers {
+		writeLong(w, v)
+	}
+}
+
+func (h HunkBin) Write(w io.Writer) {
+	writeLong(w, uint32(h.htype))
+	writeLong(w, uint32((len(h.Bytes)+3)/4))
+	writeData(w, h.Bytes)
+}
+
+func (h HunkBss) Write(w io.Writer) {
+	writeLong(w, HUNK_BSS)
+	writeLong(w, h.Size/4)
+}
+
+func (h HunkReloc32) Write(w io.Writer) {
+	writeLong(w, HUNK_RELOC32)
+	for _, r := range h.Reloc {
+		writeLong(w, uint32(len(r.Offsets)))
+		writeLong(w, r.HunkRef)
+		for _, o := range r.Offsets {
+			writeLong(w, o)
+		}
+	}
+	writeLong(w, 0)
+}
+
+func (h HunkEnd) Write(w io.Writer) {
+	writeLong(w, HUNK_END)
+}
+
+func (h HunkLz4) Write(w io.Writer) {
+	writeLong(w, HUNK_LZ4)
+	writeLong(w, uint32(h.Packed))
+	writeLong(w, h.Size/4)
+	writeLong(w, uint32((len(h.Bytes)+3)/4))
+	writeData(w, h.Bytes)
+}
+
+type HunkWriter interface {
+	Write(w io.Writer)
+}
+
+func WriteFile(path string, hunks []Hunk) (err error) {
+	file, err := os.Create(path)
+	if err != nil {
+		return
+	}
+	defer file.Close()
+
+	w := bufio.NewWriter(file)
+	for _, h := range hunks {
+		hw, ok := h.(HunkWriter)
+		if !ok {
+			return fmt.Errorf("cannot write %s", HunkNameMap[h.Type()])
+		}
+		hw.Write(w)
+	}
+	return w.Flush()
+}
@@ -0,0 +1,161 @@
+package main
+
+/*
+ * LZ4 block format with end marker, as understood by Lz4Unpack routine
+ * from lib/libmisc/lz4unpack.S. Mirrors tools/pylib/lz4.py.
+ */
+
+const (
+	minMatch  = 4
+	maxMatch  = 65535
+	maxOffset = 65535
+	hashBits  = 16
+	depth     = 256
+)
+
+func hash(data []byte, i int) int {
+	v := uint32(data[i]) | uint32(data[i+1])<<8 |
+		uint32(data[i+2])<<16 | uint32(data[i+3])<<24
+	return int((v * 2654435761) >> (32 - hashBits))
+}
+
+func putLength(out []byte, n int) []byte {
+	for n >= 255 {
+		out = append(out, 255)
+		n -= 255
+	}
+	return append(out, byte(n))
+}
+
+func putSequence(out, data []byte, lit, pos, offset, length int) []byte {
+	literals := pos - lit
+	mlen := 0
+	if offset > 0 {
+		mlen = length - minMatch
+	}
+	out = append(out, byte(min(literals, 15)<<4|min(mlen, 15)))
+	if literals >= 15 {
+		out = putLength(out, literals-15)
+	}
+	out = append(out, data[lit:pos]...)
+	out = append(out, byte(offset), byte(offset>>8))
+	if offset > 0 && mlen >= 15 {
+		out = putLength(out, mlen-15)
+	}
+	return out
+}
+
+func min(a, b int) int {
+	if a < b {
+		return a
+	}
+	return b
+}
+
+type matcher struct {
+	data []byte
+	head []int
+	prev []int
+	last int
+}
+
+func (m *matcher) update(pos int) {
+	for m.last < pos && m.last+minMatch <= len(m.data) {
+		h := hash(m.data, m.last)
+		m.prev[m.last&maxOffset] = m.head[h]
+		m.head[h] = m.last
+		m.last++
+	}
+}
+
+func (m *matcher) longest(i int) (bestLen, bestOff int) {
+	data := m.data
+	limit := min(maxMatch, len(data)-i)
+	for j, n := m.head[hash(data, i)], depth; j >= 0 && n > 0 && i-j <= maxOffset; n-- {
+		if data[j+bestLen] == data[i+bestLen] {
+			k := 0
+			for k < limit && data[j+k] == data[i+k] {
+				k++
+			}
+			if k > bestLen {
+				bestLen, bestOff = k, i-j
+				if k == limit {
+					break
+				}
+			}
+		}
+		j = m.prev[j&maxOffset]
+	}
+	return
+}
+
+func Lz4Compress(data []byte) []byte {
+	m := matcher{data: data, head: make([]int, 1<<hashBits),
+		prev: make([]int, maxOffset+1)}
+	for i := range m.head {
+		m.head[i] = -1
+	}
+	for i := range m.prev {
+		m.prev[i] = -1
+	}
+
+	var out []byte
+	end := len(data)
+	lit, i := 0, 0
+	for i+minMatch <= end {
+		m.update(i)
+		length, offset := m.longest(i)
+		if length < minMatch {
+			i++
+			continue
+		}
+		if i+1+minMatch <= end {
+			m.update(i + 1)
+			if length1, offset1 := m.longest(i + 1); length1 > length {
+				i++
+				length, offset = length1, offset1
+			}
+		}
+		out = putSequence(out, data, lit, i, offset, length)
+		i += length
+		lit = i
+	}
+	return putSequence(out, data, lit, end, 0, 0)
+}
+
+func Lz4Decompress(data []byte) []byte {
+	var out []byte
+	readLength := func(i, n int) (int, int) {
+		for {
+			b := int(data[i])
+			i++
+			n += b
+			if b != 255 {
+				return i, n
+			}
+		}
+	}
+	for i := 0; ; {
+		token := int(data[i])
+		i++
+		literals := token >> 4
+		if literals == 15 {
+			i, literals = readLength(i, literals)
+		}
+		out = append(out, data[i:i+literals]...)
+		i += literals
+		offset := int(data[i]) | int(data[i+1])<<8
+		i += 2
+		if offset == 0 {
+			return out
+		}
+		length := token & 15
+		if length == 15 {
+			i, length = readLength(i, length)
+		}
+		start := len(out) - offset
+		for k := 0; k < length+minMatch; k++ {
+			out = append(out, out[start+k])
+		}
+	}
+}
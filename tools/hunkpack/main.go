@@ -0,0 +1,75 @@
+package main
+
+import (
+	"bytes"
+	"flag"
+	"fmt"
+	"ghostown.pl/hunk"
+	"os"
+)
+
+var printHelp bool
+var minSize int
+
+func init() {
+	flag.BoolVar(&printHelp, "help", false,
+		"print help message and exit")
+	flag.IntVar(&minSize, "min", 256,
+		"do not compress hunks smaller than given number of bytes")
+}
+
+/*
+ * Replaces HUNK_CODE and HUNK_DATA with HUNK_LZ4 if that makes the hunk
+ * smaller. Debug and symbol information is dropped. The result is meant
+ * to be loaded by LoadHunkList from loader/kernel/amigahunk.c, which is not
+ * the case for the executable loaded by the boot block.
+ */
+func pack(hunks []hunk.Hunk) (out []hunk.Hunk, before, after int) {
+	for _, h := range hunks {
+		switch h.Type() {
+		case hunk.HUNK_SYMBOL, hunk.HUNK_DEBUG:
+			continue
+		case hunk.HUNK_CODE, hunk.HUNK_DATA:
+			bin := h.(hunk.HunkBin)
+			before += len(bin.Bytes)
+			if len(bin.Bytes) >= minSize {
+				packed := Lz4Compress(bin.Bytes)
+				if !bytes.Equal(Lz4Decompress(packed), bin.Bytes) {
+					panic("compression failed")
+				}
+				if (len(packed)+3)&^3+8 < len(bin.Bytes) {
+					h = hunk.HunkLz4{Packed: bin.Type(),
+						Size: uint32(len(bin.Bytes)), Bytes: packed}
+					after += len(packed)
+					break
+				}
+			}
+			after += len(bin.Bytes)
+		}
+		out = append(out, h)
+	}
+	return
+}
+
+func main() {
+	flag.Parse()
+
+	if len(flag.Args()) < 2 || printHelp {
+		fmt.Println("Usage: hunkpack [options] input.exe output.exe")
+		flag.PrintDefaults()
+		os.Exit(1)
+	}
+
+	hunks, err := hunk.ReadFile(flag.Arg(0))
+	if err != nil {
+		panic("failed to read Amiga Hunk file")
+	}
+
+	hunks, before, after := pack(hunks)
+
+	if err := hunk.WriteFile(flag.Arg(1), hunks); err != nil {
+		panic(err)
+	}
+
+	fmt.Printf("code & data: %d bytes -> %d bytes\n", before, after)
+}
@@ -66,6 +66,14 @@ class SOCAT(Launchable):
             'STDIO', 'tcp:localhost:%d,retry,forever,interval=0.01' % tcp_port]
 
 
+class REMOTEFS(Launchable):
+    def __init__(self):
+        super().__init__('serial', HerePath('tools', 'remotefs.py'))
+
+    def configure(self, tcp_port, dirs):
+        self.options = ['-p', str(tcp_port)] + dirs
+
+
 class GDB(Launchable):
     def __init__(self):
         super().__init__('gdb', 'm68k-amigaos-gdb')
@@ -96,6 +104,9 @@ if __name__ == '__main__':
     parser.add_argument('-d', '--debug', choices=['gdbserver', 'gdb'],
                         help=('Run gdbserver on {} and launch gdb '
                               'if requested.'.format(REMOTE)))
+    parser.add_argument('-s', '--serve', metavar='DIR', type=str,
+                        action='append',
+                        help='Serve files from directory over serial port.')
     parser.add_argument('-w', '--window', metavar='WIN', type=str,
                         default='fs-uae',
                         help='Select tmux window name to switch to.')
@@ -116,8 +127,12 @@ if __name__ == '__main__':
     uae = FSUAE()
     uae.configure(floppy=args.floppy, rom=args.rom, debug=args.debug)
 
-    ser_port = SOCAT('serial')
-    ser_port.configure(tcp_port=8000)
+    if args.serve:
+        ser_port = REMOTEFS()
+        ser_port.configure(tcp_port=8000, dirs=args.serve)
+    else:
+        ser_port = SOCAT('serial')
+        ser_port.configure(tcp_port=8000)
 
     par_port = SOCAT('parallel')
     par_port.configure(tcp_port=8001)
@@ -395,85 +395,409 @@ class LWOB(IffFile, LWOParserMixin):
         return self.get('POLS')
 
 
-def convertLWO2(lwo, name, scale):
-    tags = list(lwo['TAGS'].data)
-    clips = lwo.get('CLIP', always_list=True)
+class Mesh(object):
+    """
+    Geometry of an object in fixed point, as it will be written out.
+    Texture coordinates are kept as (surface, vertex, (u, v)) triples.
+    Morph targets are kept as (name, {vertex: (dx, dy, dz)}) pairs.
+    """
+
+    def __init__(self, points, polygons, surfaces, uvs, morphs=()):
+        self.points = points
+        self.polygons = polygons
+        self.surfaces = surfaces
+        self.uvs = uvs
+        self.morphs = list(morphs)
+
+    def remap(self, points, remap):
+        """
+        Replaces vertices with new ones as given by 'remap' list. Polygons
+        that became degenerate or duplicated are removed.
+        """
+        polygons, surfaces, seen = [], [], set()
+
+        for polygon, surface in zip(self.polygons, self.surfaces):
+            polygon = [remap[v] for v in polygon]
+            polygon = [v for i, v in enumerate(polygon)
+                       if v != polygon[i - 1]]
+            if len(set(polygon)) < 3:
+                continue
+            # the same cycle of vertices may start at any position
+            k = polygon.index(min(polygon))
+            key = tuple(polygon[k:] + polygon[:k])
+            if key in seen:
+                continue
+            seen.add(key)
+            polygons.append(tuple(polygon))
+            surfaces.append(surface)
+
+        uvs, seen = [], set()
+        for surface, vertex, uv in self.uvs:
+            vertex = remap[vertex]
+            if (surface, vertex) not in seen:
+                seen.add((surface, vertex))
+                uvs.append((surface, vertex, uv))
+
+        morphs = []
+        for morph_name, deltas in self.morphs:
+            moved = {}
+            for vertex, delta in deltas.items():
+                moved.setdefault(remap[vertex], delta)
+            morphs.append((morph_name, moved))
+
+        return Mesh(points, polygons, surfaces, uvs, morphs)
+
+    def size(self):
+        return max([max(abs(c) for c in p) for p in self.points] or [0])
+
+
+def weld(mesh, grid=1):
+    """
+    Merges vertices that end up at the same position after snapping to
+    a grid and have the same texture coordinates and morph deltas.
+    """
+    uv = {}
+    for surface, vertex, coords in mesh.uvs:
+        uv.setdefault(vertex, []).append((surface, coords))
+
+    points, remap, seen = [], [], {}
+    for i, p in enumerate(mesh.points):
+        if grid > 1:
+            p = tuple(int(round(c / grid)) * grid for c in p)
+        key = (p, tuple(sorted(uv.get(i, []))),
+               tuple(deltas.get(i) for _, deltas in mesh.morphs))
+        if key not in seen:
+            seen[key] = len(points)
+            points.append(p)
+        remap.append(seen[key])
+
+    return mesh.remap(points, remap)
+
+
+def cluster(mesh, cell):
+    """
+    Simplifies the mesh by collapsing all vertices within a cube of given
+    size into their average. Returns new mesh and the largest distance
+    (along an axis) a vertex was moved by.
+    """
+    cells, members = {}, []
+    remap = []
+    for p in mesh.points:
+        key = tuple(c // cell for c in p)
+        if key not in cells:
+            cells[key] = len(members)
+            members.append([])
+        members[cells[key]].append(p)
+        remap.append(cells[key])
+
+    points = []
+    for ps in members:
+        points.append(tuple(int(round(sum(c) / len(ps))) for c in zip(*ps)))
+
+    error = max(max(abs(a - b) for a, b in zip(p, points[k]))
+                for p, k in zip(mesh.points, remap))
+
+    # drop faces that became too thin to have a normal vector
+    mesh = mesh.remap(points, remap)
+    keep = [i for i, polygon in enumerate(mesh.polygons)
+            if faceNormal(mesh.points, polygon)]
+    mesh.polygons = [mesh.polygons[i] for i in keep]
+    mesh.surfaces = [mesh.surfaces[i] for i in keep]
+
+    return mesh, error
+
+
+def reorder(mesh, cache=16):
+    """
+    Orders polygons so that consecutive ones share vertices. Greedily picks
+    a polygon that uses most of recently visited vertices. Then vertices are
+    numbered in order of first use, so that they are accessed sequentially.
+    """
+    polygons = mesh.polygons
+    users = {}
+    for i, polygon in enumerate(polygons):
+        for v in polygon:
+            users.setdefault(v, []).append(i)
+
+    done = [False] * len(polygons)
+    order, recent = [], []
+    seed = 0
+
+    while len(order) < len(polygons):
+        best, score = None, 0
+        for v in recent:
+            for i in users[v]:
+                if done[i]:
+                    continue
+                n = sum(1 for u in polygons[i] if u in recent)
+                if n > score or (n == score and i < best):
+                    best, score = i, n
+        if best is None:
+            while done[seed]:
+                seed += 1
+            best = seed
+        done[best] = True
+        order.append(best)
+        for v in polygons[best]:
+            if v in recent:
+                recent.remove(v)
+            recent.append(v)
+        recent = recent[-cache:]
+
+    remap = [None] * len(mesh.points)
+    count = 0
+    for i in order:
+        for v in polygons[i]:
+            if remap[v] is None:
+                remap[v] = count
+                count += 1
+    # vertices that do not belong to any polygon go last
+    for v, k in enumerate(remap):
+        if k is None:
+            remap[v] = count
+            count += 1
+
+    points = [None] * len(mesh.points)
+    for v, k in enumerate(remap):
+        points[k] = mesh.points[v]
+
+    reordered = Mesh(mesh.points, [polygons[i] for i in order],
+                     [mesh.surfaces[i] for i in order], mesh.uvs,
+                     mesh.morphs)
+    return reordered.remap(points, remap)
+
+
+#
+# Following routines mirror lib/lib3d/Calculate*.c bit for bit, so that
+# results computed on the host are the same as computed on the target.
+#
+SQRT = [
+    0, 1, 1, 2, 2, 4, 5, 8, 11, 16, 22, 32, 45, 64, 90, 128, 181, 256, 362,
+    512, 724, 1024, 1448, 2048, 2896, 4096, 5792, 8192, 11585, 16384, 23170,
+    32768, 46340, 32768, 33276, 33776, 34269, 34755, 35235, 35708, 36174,
+    36635, 37090, 37540, 37984, 38423, 38858, 39287, 39712, 40132, 40548,
+    40960, 41367, 41771, 42170, 42566, 42959, 43347, 43733, 44115, 44493,
+    44869, 45241, 45611, 45977]
+
+
+def s16(x):
+    return ((x + 0x8000) & 0xffff) - 0x8000
+
+
+def s32(x):
+    return ((x + 0x80000000) & 0xffffffff) - 0x80000000
+
+
+def div16(a, b):
+    q = abs(a) // abs(b)
+    return s16(q if (a < 0) == (b < 0) else -q)
+
+
+def isqrt(x):
+    """ Mirrors isqrt from lib/libmisc/fx.c """
+    n = (x & 0xffffffff).bit_length()
+    t = (x << (6 - n)) if n <= 6 else (x >> (n - 6))
+    t = (t & 31) + 33
+    return ((SQRT[n] * SQRT[t] << 1) & 0xffffffff) >> 16
+
+
+def faceNormal(points, polygon):
+    """ Returns None if the normal vector has zero length. """
+    p1, p2, p3 = [points[v] for v in polygon[:3]]
+    ax, ay, az = [s16(a - b) for a, b in zip(p1, p2)]
+    bx, by, bz = [s16(a - b) for a, b in zip(p2, p3)]
+    x = s32(ay * bz - by * az)
+    y = s32(az * bx - bz * ax)
+    z = s32(ax * by - bx * ay)
+    nx, ny, nz = s16(x >> 12), s16(y >> 12), s16(z >> 12)
+    l = s16(isqrt(s32(nx * nx + ny * ny + nz * nz)))
+    if l != 0:
+        return (div16(x, l), div16(y, l), div16(z, l))
+
+
+def faceNormals(mesh):
+    normals = []
+    for i, polygon in enumerate(mesh.polygons):
+        normal = faceNormal(mesh.points, polygon)
+        if normal is None:
+            raise SystemExit('#%d face normal vector has zero length!' % i)
+        normals.append(normal)
+    return normals
+
+
+def edges(mesh):
+    """
+    Returns edges sorted by their vertices and for each face a list of its
+    edge numbers in ascending order.
+    """
+    def key(polygon, i):
+        return tuple(sorted((polygon[i - 1], polygon[i])))
+
+    edges = sorted(set(key(p, i) for p in mesh.polygons
+                       for i in range(len(p))))
+    number = dict((e, i) for i, e in enumerate(edges))
+    faceEdges = [sorted(number[key(p, i)] for i in range(len(p)))
+                 for p in mesh.polygons]
+    return edges, faceEdges
+
+
+def vertexFaces(mesh):
+    faces = [[] for _ in mesh.points]
+    for i, polygon in enumerate(mesh.polygons):
+        for v in polygon:
+            faces[v].append(i)
+    return faces
+
+
+def vertexNormals(mesh, faceNormals, vertexFaces):
+    normals = []
+    for faces in vertexFaces:
+        if not faces:
+            normals.append((0, 0, 0))
+            continue
+        n = len(faces)
+        normals.append(tuple(div16(sum(faceNormals[f][i] for f in faces), n)
+                             for i in range(3)))
+    return normals
+
+
+def printIndexLists(name, lists):
+    """ Flattens lists into a single array with a table of pointers. """
+    size = sum(len(l) + 1 for l in lists)
+    print('static short _%s_data[%d] = {' % (name, size))
+    for l in lists:
+        print('  %d, %s' % (len(l), ''.join('%d, ' % i for i in l).strip()))
+    print('};\n')
 
-    if clips:
-        print('static MeshImageT _%s_img[%d] = {' % (name, len(clips)))
-        for clip in clips:
-            index, imag = clip.data
-            print('  [%d] = {' % index)
-            print('    .pixmap = NULL,')
-            print('    .filename = "%s",' % imag['STIL'])
-            print('  },')
+    print('static IndexListT *_%s[%d] = {' % (name, len(lists) + 1))
+    offset = 0
+    for l in lists:
+        print('  (IndexListT *)&_%s_data[%d],' % (name, offset))
+        offset += len(l) + 1
+    print('  NULL')
+    print('};\n')
+
+
+def printTopology(mesh, prefix):
+    faceNormal = faceNormals(mesh)
+    edge, faceEdge = edges(mesh)
+    vertexFace = vertexFaces(mesh)
+    vertexNormal = vertexNormals(mesh, faceNormal, vertexFace)
+
+    for what, normals in [('face_normal', faceNormal),
+                          ('pnts_normal', vertexNormal)]:
+        print('static Point3D _%s_%s[%d] = {' % (prefix, what, len(normals)))
+        for x, y, z in normals:
+            print('  {.x = %5d, .y = %5d, .z = %5d, .pad = 0},' % (x, y, z))
         print('};\n')
 
-    txuv = {}
-    for vmap in lwo.get('VMAP', always_list=True):
-        if vmap.data[0] == 'TXUV':
-            txuv[vmap.data[2]] = vmap.data[3]
+    # edges refer to vertices by their offset in Point3D array
+    print('static EdgeT _%s_edge[%d] = {' % (prefix, len(edge)))
+    for p0, p1 in edge:
+        print('  {.p0 = %d, .p1 = %d},' % (p0 * 8, p1 * 8))
+    print('};\n')
 
-    srfs = list(tags)
-    for surf in lwo.get('SURF', always_list=True):
-        i = tags.index(surf.data[0])
-        srfs[i] = (surf.data[0], surf.data[2])
+    printIndexLists('%s_face_edge' % prefix, faceEdge)
+    printIndexLists('%s_pnts_face' % prefix, vertexFace)
 
-    print('static MeshSurfaceT _%s_surf[%d] = {' % (name, len(tags)))
+    return len(edge)
 
-    surf_vmap = {}
-    for surf in srfs:
-        if type(surf) is str:
-            continue
-        surf_name, surf = surf
 
-        surf_index = tags.index(surf_name)
-        r, g, b = 0, 0, 0
-        sideness = 0
-        texture = -1
-        for key, value in surf.items():
-            if key == 'COLR':
-                r, g, b = value
-            if key == 'SIDE':
-                sideness = value
-            if key == 'BLOK':
-                for key, value in value.items():
-                    if key == 'IMAG':
-                        texture = value
-                    if key == 'VMAP':
-                        surf_vmap[value] = tags.index(surf_name)
+def morphNormals(mesh, normals, deltas):
+    """ Returns changes of face normals with morph target at full weight. """
+    points = list(mesh.points)
+    for vertex, delta in deltas.items():
+        points[vertex] = tuple(s16(a + b)
+                               for a, b in zip(points[vertex], delta))
 
-        print('  [%d] = { /* name = "%s" */' % (surf_index, surf_name))
-        print('    .r = %d, .g = %d, .b = %d,' % (r, g, b))
-        print('    .sideness = %d,' % sideness)
-        print('    .texture = %d,' % texture)
+    changes = {}
+    for i, polygon in enumerate(mesh.polygons):
+        normal = faceNormal(points, polygon)
+        if normal is None:
+            logging.warning('#%d face normal vector has zero length when '
+                            'morphed, keeping the original one.' % i)
+            continue
+        delta = tuple(s16(a - b) for a, b in zip(normal, normals[i]))
+        if delta != (0, 0, 0):
+            changes[i] = delta
+    return changes
+
+
+def printMorphDeltas(name, deltas):
+    if not deltas:
+        return 'NULL'
+    print('static MorphDeltaT _%s[%d] = {' % (name, len(deltas)))
+    for i, (x, y, z) in sorted(deltas.items()):
+        print('  {.offset = %4d, .x = %5d, .y = %5d, .z = %5d},' %
+              (i * 8, x, y, z))
+    print('};\n')
+    return '_' + name
+
+
+def printMorphs(mesh, prefix):
+    normals = faceNormals(mesh)
+    targets = []
+
+    for i, (morph_name, deltas) in enumerate(mesh.morphs):
+        changes = morphNormals(mesh, normals, deltas)
+        vertex = printMorphDeltas('%s_morph%d_pnts' % (prefix, i), deltas)
+        normal = printMorphDeltas('%s_morph%d_face_normal' % (prefix, i),
+                                  changes)
+        targets.append((morph_name, len(deltas), len(changes), vertex,
+                        normal))
+
+    print('static MorphTargetT _%s_morph[%d] = {' % (prefix, len(targets)))
+    for i, (morph_name, vertices, faces, vertex, normal) in \
+            enumerate(targets):
+        print('  [%d] = { /* name = "%s" */' % (i, morph_name))
+        print('    .vertices = %d,' % vertices)
+        print('    .faces = %d,' % faces)
+        print('    .vertex = %s,' % vertex)
+        print('    .faceNormal = %s,' % normal)
         print('  },')
     print('};\n')
 
-    pnts = lwo['PNTS']
-    print('static Point3D _%s_pnts[%d] = {' % (name, len(pnts.data)))
-    for point in pnts.data:
-        x = int(point[0] * scale * 16)
-        y = int(point[1] * scale * 16)
-        z = int(point[2] * scale * 16)
-        print('  {.x = %5d, .y = %5d, .z = %5d, .pad = 0},' % (x, y, z))
-    print('};\n')
 
-    vmap_txuv = []
-    for name, values in txuv.items():
-        surface = surf_vmap.get(name, None)
+def readMesh(lwo, scale, surf_vmap):
+    def fixed(point):
+        return tuple(int(c * scale * 16) for c in point)
+
+    txuv = {}
+    morf, spot = [], []
+    for vmap in lwo.get('VMAP', always_list=True):
+        if vmap.data[0] == 'TXUV':
+            txuv[vmap.data[2]] = vmap.data[3]
+        # MORF holds displacements, SPOT holds absolute positions
+        if vmap.data[0] == b'MORF':
+            morf.append(vmap.data[2:])
+        if vmap.data[0] == b'SPOT':
+            spot.append(vmap.data[2:])
+
+    points = []
+    for point in lwo['PNTS'].data:
+        points.append(fixed(point))
+
+    morphs = []
+    for relative, vmaps in [(True, morf), (False, spot)]:
+        for morph_name, values in vmaps:
+            deltas = {}
+            for vertex, value in values:
+                if relative:
+                    value = [a + b for a, b in zip(lwo['PNTS'].data[vertex],
+                                                   value)]
+                delta = tuple(a - b for a, b in zip(fixed(value),
+                                                    points[vertex]))
+                if delta != (0, 0, 0):
+                    deltas[vertex] = delta
+            morphs.append((morph_name, deltas))
+
+    uvs = []
+    for vmap_name, values in txuv.items():
+        surface = surf_vmap.get(vmap_name, None)
         if not surface:
             continue
         for vertex, uv in values:
-            vmap_txuv.append((surface, vertex, tuple(uv)))
-
-    if vmap_txuv:
-        print('static UVCoord _%s_pnts_uv[%d] = {' % (name, len(vmap_txuv)))
-        for _, _, uv in vmap_txuv:
-            u = int(uv[0] * 16)
-            v = int(uv[1] * 16)
-            print('  {.u = %5d, .v = %5d},' % (u, v))
-        print('};\n')
+            uvs.append((surface, vertex, tuple(uv)))
 
     pols_surf = {}
     for ptag in lwo.get('PTAG', always_list=True):
@@ -482,67 +806,208 @@ def convertLWO2(lwo, name, scale):
             for polygon, surface in ptag:
                 pols_surf[polygon] = surface
 
-    pols = lwo['POLS'].data[1]
-    print('static IndexListT *_%s_face[%d] = {' % (name, len(pols) + 1))
+    polygons = lwo['POLS'].data[1]
+    surfaces = [pols_surf[i] for i in range(len(polygons))]
+
+    return Mesh(points, polygons, surfaces, uvs, morphs)
+
+
+def printMesh(mesh, name, prefix, surfaces, images, topology=False):
+    pols = mesh.polygons
+    edges = 0
+
+    print('static Point3D _%s_pnts[%d] = {' % (prefix, len(mesh.points)))
+    for x, y, z in mesh.points:
+        print('  {.x = %5d, .y = %5d, .z = %5d, .pad = 0},' % (x, y, z))
+    print('};\n')
+
+    if mesh.uvs:
+        print('static UVCoord _%s_pnts_uv[%d] = {' % (prefix, len(mesh.uvs)))
+        for _, _, uv in mesh.uvs:
+            u = int(uv[0] * 16)
+            v = int(uv[1] * 16)
+            print('  {.u = %5d, .v = %5d},' % (u, v))
+        print('};\n')
+
+    print('static IndexListT *_%s_face[%d] = {' % (prefix, len(pols) + 1))
     for i, polygon in enumerate(pols):
         print('  (IndexListT *)(short[%d]){%d, %s},' % (
             len(polygon) + 1, len(polygon), ', '.join(map(str, polygon))))
     print('  NULL')
     print('};\n')
 
-    print('static u_char _%s_face_surf[%d] = {' % (name, len(pols)))
-    for i, _ in enumerate(pols):
-        print('  %d,' % pols_surf[i])
+    print('static u_char _%s_face_surf[%d] = {' % (prefix, len(pols)))
+    for surface in mesh.surfaces:
+        print('  %d,' % surface)
     print('};\n')
 
-    if vmap_txuv:
+    if mesh.uvs:
         pols_txuv = {}
-        for i, txuv in enumerate(vmap_txuv):
+        for i, txuv in enumerate(mesh.uvs):
             surface, vertex, _ = txuv
             surf_dict = pols_txuv.get(surface, {})
             surf_dict[vertex] = i
             pols_txuv[surface] = surf_dict
 
-        print('static IndexListT *_%s_face_uv[%d] = {' % (name, len(pols) + 1))
+        print('static IndexListT *_%s_face_uv[%d] = {' % (
+            prefix, len(pols) + 1))
         for i, vertices in enumerate(pols):
-            surface = pols_surf[i]
+            surface = mesh.surfaces[i]
             vertices = [str(pols_txuv[surface][v]) for v in vertices]
             print('  (IndexListT *)(short[%d]){%d, %s},' % (
                 len(vertices) + 1, len(vertices), ', '.join(vertices)))
         print('  NULL')
         print('};\n')
 
+    if topology:
+        edges = printTopology(mesh, prefix)
+
+    if mesh.morphs:
+        printMorphs(mesh, prefix)
+
     # TODO: image
-    print('Mesh3D %s = {' % name)
-    print('  .vertices = %d,' % len(pnts.data))
+    print('Mesh3D %s = {' % prefix)
+    print('  .vertices = %d,' % len(mesh.points))
     print('  .faces = %d,' % len(pols))
-    print('  .edges = 0,')
-    print('  .surfaces = %d,' % len(tags))
-    print('  .images = %d,' % len(clips))
-    print('  .vertex = _%s_pnts,' % name)
-    if vmap_txuv:
-        print('  .uv = _%s_pnts_uv,' % name)
+    print('  .edges = %d,' % edges)
+    print('  .surfaces = %d,' % surfaces)
+    print('  .images = %d,' % images)
+    print('  .morphs = %d,' % len(mesh.morphs))
+    print('  .vertex = _%s_pnts,' % prefix)
+    if mesh.uvs:
+        print('  .uv = _%s_pnts_uv,' % prefix)
     else:
         print('  .uv = NULL,')
-    print('  .faceNormal = NULL,')
-    print('  .faceSurface = _%s_face_surf,' % name)
-    print('  .vertexNormal = NULL,')
-    print('  .edge = NULL,')
-    print('  .face = _%s_face,' % name)
-    print('  .faceEdge = NULL,')
-    if vmap_txuv:
-        print('  .faceUV = _%s_face_uv,' % name)
+    if topology:
+        print('  .faceNormal = _%s_face_normal,' % prefix)
+    else:
+        print('  .faceNormal = NULL,')
+    print('  .faceSurface = _%s_face_surf,' % prefix)
+    if topology:
+        print('  .vertexNormal = _%s_pnts_normal,' % prefix)
+    else:
+        print('  .vertexNormal = NULL,')
+    if topology:
+        print('  .edge = _%s_edge,' % prefix)
+    else:
+        print('  .edge = NULL,')
+    print('  .face = _%s_face,' % prefix)
+    if topology:
+        print('  .faceEdge = _%s_face_edge,' % prefix)
+    else:
+        print('  .faceEdge = NULL,')
+    if mesh.uvs:
+        print('  .faceUV = _%s_face_uv,' % prefix)
     else:
         print('  .faceUV = NULL,')
-    print('  .vertexFace = NULL,')
-    if len(clips):
+    if topology:
+        print('  .vertexFace = _%s_pnts_face,' % prefix)
+    else:
+        print('  .vertexFace = NULL,')
+    if images:
         print('  .image = _%s_img,' % name)
     else:
         print('  .image = NULL,')
     print('  .surface = _%s_surf,' % name)
+    if mesh.morphs:
+        print('  .morph = _%s_morph,' % prefix)
+    else:
+        print('  .morph = NULL,')
     print('};')
 
 
+def convertLWO2(lwo, name, scale, optimize=False, grid=1, lod=0,
+                topology=False):
+    tags = list(lwo['TAGS'].data)
+    clips = lwo.get('CLIP', always_list=True)
+
+    if clips:
+        print('static MeshImageT _%s_img[%d] = {' % (name, len(clips)))
+        for clip in clips:
+            index, imag = clip.data
+            print('  [%d] = {' % index)
+            print('    .pixmap = NULL,')
+            print('    .filename = "%s",' % imag['STIL'])
+            print('  },')
+        print('};\n')
+
+    srfs = list(tags)
+    for surf in lwo.get('SURF', always_list=True):
+        i = tags.index(surf.data[0])
+        srfs[i] = (surf.data[0], surf.data[2])
+
+    print('static MeshSurfaceT _%s_surf[%d] = {' % (name, len(tags)))
+
+    surf_vmap = {}
+    for surf in srfs:
+        if type(surf) is str:
+            continue
+        surf_name, surf = surf
+
+        surf_index = tags.index(surf_name)
+        r, g, b = 0, 0, 0
+        sideness = 0
+        texture = -1
+        for key, value in surf.items():
+            if key == 'COLR':
+                r, g, b = value
+            if key == 'SIDE':
+                sideness = value
+            if key == 'BLOK':
+                for key, value in value.items():
+                    if key == 'IMAG':
+                        texture = value
+                    if key == 'VMAP':
+                        surf_vmap[value] = tags.index(surf_name)
+
+        print('  [%d] = { /* name = "%s" */' % (surf_index, surf_name))
+        print('    .r = %d, .g = %d, .b = %d,' % (r, g, b))
+        print('    .sideness = %d,' % sideness)
+        print('    .texture = %d,' % texture)
+        print('  },')
+    print('};\n')
+
+    mesh = readMesh(lwo, scale, surf_vmap)
+
+    if optimize:
+        vertices, faces = len(mesh.points), len(mesh.polygons)
+        mesh = reorder(weld(mesh, grid))
+        logging.info('Optimized mesh from %d vertices and %d faces '
+                     'to %d vertices and %d faces.' %
+                     (vertices, faces, len(mesh.points), len(mesh.polygons)))
+
+    printMesh(mesh, name, name, len(tags), len(clips), topology)
+
+    if lod:
+        # Cells of the coarsest level split object in half along each axis.
+        cell = max(mesh.size() >> lod, 1)
+        levels = [(0, name)]
+
+        for i in range(1, lod + 1):
+            simple, error = cluster(mesh, cell << (i - 1))
+            if len(simple.polygons) < 4:
+                logging.warning('LOD level %d has too few faces, stopping.' %
+                                i)
+                break
+            simple = reorder(simple)
+            logging.info('LOD level %d: %d vertices, %d faces, error %d.' %
+                         (i, len(simple.points), len(simple.polygons),
+                          error))
+            prefix = '%s_lod%d' % (name, i)
+            print('')
+            printMesh(simple, name, prefix, len(tags), len(clips),
+                      topology)
+            levels.append((error, prefix))
+
+        print('\nMeshLOD3D %s_lod = {' % name)
+        print('  .levels = %d,' % len(levels))
+        print('  .level = {')
+        for error, prefix in levels:
+            print('    { .error = %d, .mesh = &%s },' % (error, prefix))
+        print('  }')
+        print('};')
+
+
 if __name__ == '__main__':
     parser = argparse.ArgumentParser(
         description=("Converts Lightwave Object(LWOB/LWO2) "
@@ -553,6 +1018,18 @@ if __name__ == '__main__':
     parser.add_argument(
         '-s', '--scale', type=float, default=1.0,
         help='Scale factor for vertices.')
+    parser.add_argument(
+        '-O', '--optimize', action='store_true',
+        help='Weld vertices and reorder faces and vertices for locality.')
+    parser.add_argument(
+        '-g', '--grid', type=int, default=1,
+        help='Snap vertices to a grid of given size before welding.')
+    parser.add_argument(
+        '-l', '--lod', type=int, default=0,
+        help='Number of simplified meshes to generate.')
+    parser.add_argument(
+        '-t', '--topology', action='store_true',
+        help='Precompute normals, edges and vertex to face map.')
     parser.add_argument(
         '-f', '--force', action='store_true',
         help='If the output object exists, the tool will' 'overwrite it.')
@@ -595,4 +1072,5 @@ if __name__ == '__main__':
         logging.info('Writing object structure to %s file.' % args.output)
         with open(str(args.output), 'w') as f:
             with redirect_stdout(f):
-                convertLWO2(lwo, name, args.scale)
+                convertLWO2(lwo, name, args.scale, args.optimize, args.grid,
+                            args.lod, args.topology)
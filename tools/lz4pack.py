@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+
+import argparse
+import os.path
+
+from lz4 import compress, decompress
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Compresses a file for Lz4Unpack routine.')
+    parser.add_argument('-d', '--depth', type=int, default=64,
+                        help='Number of match candidates to examine.')
+    parser.add_argument('-a', '--array', metavar='NAME', type=str,
+                        help='Output C array of given name instead of '
+                             'binary file.')
+    parser.add_argument('-c', '--chip', action='store_true',
+                        help='Place C array in chip memory.')
+    parser.add_argument('input', metavar='INPUT', type=str,
+                        help='Input filename.')
+    parser.add_argument('output', metavar='OUTPUT', type=str,
+                        help='Output filename.')
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.input):
+        raise SystemExit('Input file "%s" does not exist!' % args.input)
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    packed = compress(data, depth=args.depth)
+
+    if decompress(packed) != data:
+        raise SystemExit('Verification of "%s" failed!' % args.input)
+
+    if args.array:
+        with open(args.output, 'w') as f:
+            chip = '__data_chip ' if args.chip else ''
+            f.write('#define %s_size %d\n\n' % (args.array, len(data)))
+            f.write('static %su_char %s[%d] = {\n' %
+                    (chip, args.array, len(packed)))
+            for i in range(0, len(packed), 16):
+                row = ['0x%02x' % b for b in packed[i:i + 16]]
+                f.write('  %s,\n' % ', '.join(row))
+            f.write('};\n')
+    else:
+        with open(args.output, 'wb') as f:
+            f.write(packed)
@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+
+import argparse
+import glob
+import os.path
+import re
+import zlib
+
+from lz4 import compress, stats
+
+#
+# Estimated 68000 cycle costs of depacker routines. LZ4 figures are counted
+# from lz4unpack.S main loop. Inflate figures are approximations for
+# inflate.S with all optimisation options enabled, calibrated against its
+# documented throughput (~25kB/s @ 7.09MHz).
+#
+LZ4_SEQUENCE = 150
+LZ4_BYTE = 22
+LZ4_EXTRA = 32
+
+INFLATE_DYNAMIC_BLOCK = 80000
+INFLATE_FIXED_BLOCK = 30000
+INFLATE_LITERAL = 260
+INFLATE_MATCH = 560
+INFLATE_MATCH_BYTE = 18
+INFLATE_STORED_BYTE = 24
+
+CLOCK = 7093790
+
+CTYPES = {'char': 1, 'u_char': 1, 'short': 2, 'u_short': 2,
+          'int': 4, 'u_int': 4, 'long': 4, 'u_long': 4}
+
+
+class BitStream():
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+        self.bit = 0
+
+    def bits(self, n):
+        v = 0
+        for i in range(n):
+            b = (self.data[self.pos] >> self.bit) & 1
+            v |= b << i
+            self.bit += 1
+            if self.bit == 8:
+                self.bit = 0
+                self.pos += 1
+        return v
+
+    def align(self):
+        if self.bit:
+            self.bit = 0
+            self.pos += 1
+
+
+def huffman(lengths):
+    codes = {}
+    code = 0
+    for n in range(1, 16):
+        for sym, l in enumerate(lengths):
+            if l == n:
+                codes[(n, code)] = sym
+                code += 1
+        code <<= 1
+    return codes
+
+
+def decode(bs, codes):
+    code = n = 0
+    while True:
+        code = (code << 1) | bs.bits(1)
+        n += 1
+        if (n, code) in codes:
+            return codes[(n, code)]
+
+
+LBASE = [3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43,
+         51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258]
+LEXTRA = [0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4,
+          4, 4, 5, 5, 5, 5, 0]
+DEXTRA = [0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9,
+          10, 10, 11, 11, 12, 12, 13, 13]
+CLORDER = [16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15]
+
+
+def inflate_cycles(data):
+    """
+    Walks raw DEFLATE stream and sums up estimated cost of decoding it.
+    """
+    bs = BitStream(data)
+    cycles = 0
+    final = 0
+    while not final:
+        final = bs.bits(1)
+        btype = bs.bits(2)
+        if btype == 0:
+            bs.align()
+            size = bs.data[bs.pos] | (bs.data[bs.pos + 1] << 8)
+            bs.pos += 4 + size
+            cycles += size * INFLATE_STORED_BYTE
+            continue
+        if btype == 1:
+            cycles += INFLATE_FIXED_BLOCK
+            litlen = huffman([8] * 144 + [9] * 112 + [7] * 24 + [8] * 8)
+            dist = huffman([5] * 30)
+        else:
+            cycles += INFLATE_DYNAMIC_BLOCK
+            hlit = bs.bits(5) + 257
+            hdist = bs.bits(5) + 1
+            hclen = bs.bits(4) + 4
+            cl = [0] * 19
+            for i in range(hclen):
+                cl[CLORDER[i]] = bs.bits(3)
+            clcodes = huffman(cl)
+            lengths = []
+            while len(lengths) < hlit + hdist:
+                sym = decode(bs, clcodes)
+                if sym < 16:
+                    lengths.append(sym)
+                elif sym == 16:
+                    lengths.extend([lengths[-1]] * (3 + bs.bits(2)))
+                elif sym == 17:
+                    lengths.extend([0] * (3 + bs.bits(3)))
+                else:
+                    lengths.extend([0] * (11 + bs.bits(7)))
+            litlen = huffman(lengths[:hlit])
+            dist = huffman(lengths[hlit:])
+        while True:
+            sym = decode(bs, litlen)
+            if sym < 256:
+                cycles += INFLATE_LITERAL
+            elif sym == 256:
+                break
+            else:
+                sym -= 257
+                length = LBASE[sym] + bs.bits(LEXTRA[sym])
+                bs.bits(DEXTRA[decode(bs, dist)])
+                cycles += INFLATE_MATCH + length * INFLATE_MATCH_BYTE
+    return cycles
+
+
+def lz4_cycles(data):
+    seqs, literals, matches, extra = stats(data)
+    return (seqs * LZ4_SEQUENCE + (literals + matches) * LZ4_BYTE +
+            extra * LZ4_EXTRA)
+
+
+def read_c_arrays(path):
+    """
+    Extracts contents of numeric arrays from C file generated by one of
+    our converters (png2c, lwo2c, etc.) and serializes them as big endian.
+    """
+    with open(path) as f:
+        text = f.read()
+
+    decl = re.compile(r'(?:static\s+)?(?:const\s+)?(?:__data_chip\s+)?'
+                      r'(u_char|char|u_short|short|u_int|int|u_long|long)'
+                      r'\s+\w+\s*\[[^\]]*\]\s*=\s*\{([^;]*)\};')
+    data = bytearray()
+    for ctype, body in decl.findall(text):
+        body = re.sub(r'/\*.*?\*/', '', body, flags=re.S)
+        values = re.findall(r'-?(?:0x[0-9a-fA-F]+|\d+)', body)
+        size = CTYPES[ctype]
+        mask = (1 << (8 * size)) - 1
+        for v in values:
+            data.extend((int(v, 0) & mask).to_bytes(size, 'big'))
+    return bytes(data)
+
+
+def read_data(path):
+    if path.endswith('.c'):
+        return read_c_arrays(path)
+    with open(path, 'rb') as f:
+        return f.read()
+
+
+def default_inputs(topdir):
+    # converted assets are what ends up in memory of the machine
+    paths = glob.glob(os.path.join(topdir, 'effects/*/data/*.c'))
+    for ext in ['ahx', 'mod', 'p61']:
+        paths.extend(glob.glob(os.path.join(topdir, 'effects/*/data/*.' + ext)))
+    return sorted(paths)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Compares LZ4 and DEFLATE compression ratio and '
+                    'estimated 68000 decompression speed.')
+    parser.add_argument('-d', '--depth', type=int, default=64,
+                        help='Number of match candidates to examine.')
+    parser.add_argument('files', metavar='FILE', type=str, nargs='*',
+                        help='Input files. C files are searched for array '
+                             'initializers. By default all generated effect '
+                             'data files are used.')
+    args = parser.parse_args()
+
+    files = args.files
+    if not files:
+        topdir = os.path.dirname(os.path.dirname(os.path.realpath(__file__)))
+        files = default_inputs(topdir)
+    if not files:
+        raise SystemExit('No input files! Build the effects first.')
+
+    fmt = '%-40s %8s %8s %6s %8s %6s %8s %8s'
+    print(fmt % ('file', 'size', 'deflate', 'ratio', 'lz4', 'ratio',
+                 'inf c/B', 'lz4 c/B'))
+
+    total = [0, 0, 0, 0, 0]
+    for path in files:
+        data = read_data(path)
+        if not data:
+            continue
+        co = zlib.compressobj(9, zlib.DEFLATED, -15)
+        deflated = co.compress(data) + co.flush()
+        packed = compress(data, depth=args.depth)
+        ic = inflate_cycles(deflated)
+        lc = lz4_cycles(packed)
+        size = len(data)
+        print(fmt % (os.path.relpath(path)[-40:], size, len(deflated),
+                     '%.3f' % (len(deflated) / size), len(packed),
+                     '%.3f' % (len(packed) / size),
+                     '%.1f' % (ic / size), '%.1f' % (lc / size)))
+        for i, v in enumerate([size, len(deflated), len(packed), ic, lc]):
+            total[i] += v
+
+    size, deflated, packed, ic, lc = total
+    if size:
+        print(fmt % ('total', size, deflated, '%.3f' % (deflated / size),
+                     packed, '%.3f' % (packed / size),
+                     '%.1f' % (ic / size), '%.1f' % (lc / size)))
+        print('Inflate: %.1f kB/s, Lz4Unpack: %.1f kB/s (7MHz 68000)' %
+              (CLOCK * size / ic / 1024, CLOCK * size / lc / 1024))
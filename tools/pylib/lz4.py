@@ -0,0 +1,166 @@
+#
+# LZ4 block format with end marker, as understood by Lz4Unpack routine from
+# lib/libmisc/lz4unpack.S. See the routine for stream format description.
+#
+
+MINMATCH = 4
+MAXMATCH = 65535
+MAXOFFSET = 65535
+HASHBITS = 16
+
+
+def _hash(data, i):
+    v = data[i] | (data[i + 1] << 8) | (data[i + 2] << 16) | (data[i + 3] << 24)
+    return ((v * 2654435761) & 0xffffffff) >> (32 - HASHBITS)
+
+
+def _length(out, n):
+    while n >= 255:
+        out.append(255)
+        n -= 255
+    out.append(n)
+
+
+def _sequence(out, data, lit, pos, offset, length):
+    literals = pos - lit
+    mlen = length - MINMATCH if offset else 0
+    out.append((min(literals, 15) << 4) | min(mlen, 15))
+    if literals >= 15:
+        _length(out, literals - 15)
+    out.extend(data[lit:pos])
+    out.append(offset & 255)
+    out.append(offset >> 8)
+    if offset and mlen >= 15:
+        _length(out, mlen - 15)
+
+
+def _longest(data, i, head, prev, depth):
+    limit = min(MAXMATCH, len(data) - i)
+    best_len, best_off = 0, 0
+    j = head[_hash(data, i)]
+    while j >= 0 and depth > 0 and i - j <= MAXOFFSET:
+        if data[j + best_len] == data[i + best_len]:
+            n = 0
+            while n < limit and data[j + n] == data[i + n]:
+                n += 1
+            if n > best_len:
+                best_len, best_off = n, i - j
+                if n == limit:
+                    break
+        j = prev[j & MAXOFFSET]
+        depth -= 1
+    return best_len, best_off
+
+
+def compress(data, depth=64, lazy=True):
+    """
+    Greedy parser with hash chains searched up to 'depth' candidates.
+    With 'lazy' enabled a match is deferred by one byte if that yields
+    a longer one.
+    """
+    data = bytes(data)
+    end = len(data)
+    head = [-1] * (1 << HASHBITS)
+    prev = [-1] * (MAXOFFSET + 1)
+    out = bytearray()
+    last = 0
+
+    def update(pos):
+        nonlocal last
+        while last < pos and last + MINMATCH <= end:
+            h = _hash(data, last)
+            prev[last & MAXOFFSET] = head[h]
+            head[h] = last
+            last += 1
+
+    lit = i = 0
+    while i + MINMATCH <= end:
+        update(i)
+        length, offset = _longest(data, i, head, prev, depth)
+        if length < MINMATCH:
+            i += 1
+            continue
+        if lazy and i + 1 + MINMATCH <= end:
+            update(i + 1)
+            length1, offset1 = _longest(data, i + 1, head, prev, depth)
+            if length1 > length:
+                i += 1
+                length, offset = length1, offset1
+        _sequence(out, data, lit, i, offset, length)
+        i += length
+        lit = i
+
+    _sequence(out, data, lit, end, 0, 0)
+    return bytes(out)
+
+
+def decompress(data):
+    out = bytearray()
+    i = 0
+    while True:
+        token = data[i]
+        i += 1
+        literals = token >> 4
+        if literals == 15:
+            while True:
+                b = data[i]
+                i += 1
+                literals += b
+                if b != 255:
+                    break
+        out.extend(data[i:i + literals])
+        i += literals
+        offset = data[i] | (data[i + 1] << 8)
+        i += 2
+        if offset == 0:
+            return bytes(out)
+        length = token & 15
+        if length == 15:
+            while True:
+                b = data[i]
+                i += 1
+                length += b
+                if b != 255:
+                    break
+        length += MINMATCH
+        start = len(out) - offset
+        for k in range(length):
+            out.append(out[start + k])
+
+
+def stats(data):
+    """
+    Walks a compressed stream and returns a tuple of: number of sequences,
+    literal bytes, match bytes and extended length bytes.
+    """
+    seqs = literals = matches = extra = 0
+    i = 0
+    while True:
+        token = data[i]
+        i += 1
+        seqs += 1
+        n = token >> 4
+        if n == 15:
+            while True:
+                b = data[i]
+                i += 1
+                n += b
+                extra += 1
+                if b != 255:
+                    break
+        literals += n
+        i += n
+        offset = data[i] | (data[i + 1] << 8)
+        i += 2
+        if offset == 0:
+            return seqs, literals, matches, extra
+        n = token & 15
+        if n == 15:
+            while True:
+                b = data[i]
+                i += 1
+                n += b
+                extra += 1
+                if b != 255:
+                    break
+        matches += n + MINMATCH
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+
+import argparse
+import logging
+import os.path
+import socket
+import time
+from struct import pack, unpack
+
+#
+# Serves files to loader/drivers/remote-file.c over emulator's serial port.
+# See the driver for protocol description.
+#
+
+ENOENT = -1
+EBADF = -2
+EINVAL = -3
+
+CHUNK = 1024
+
+
+def checksum(data):
+    a = b = 0
+    for x in data:
+        a = (a + x) & 255
+        b = (b + a) & 255
+    return (b << 8) | a
+
+
+class RemoteFS():
+    def __init__(self, sock, dirs):
+        self.sock = sock
+        self.dirs = dirs
+        self.files = {}
+        self.handle = 0
+
+    def recv(self, n):
+        data = bytearray()
+        while len(data) < n:
+            chunk = self.sock.recv(n - len(data))
+            if not chunk:
+                raise EOFError
+            data.extend(chunk)
+        return bytes(data)
+
+    def send(self, data):
+        self.sock.sendall(data)
+
+    def lookup(self, name):
+        for d in self.dirs:
+            path = os.path.join(d, name)
+            if os.path.isfile(path):
+                return path
+
+    def do_open(self, name):
+        path = self.lookup(name)
+        if path is None:
+            logging.warning('open %s: not found', name)
+            self.send(pack('>i', ENOENT))
+            return
+        # file is read whole when it is opened, so it can be changed anytime
+        with open(path, 'rb') as f:
+            data = f.read()
+        self.handle += 1
+        self.files[self.handle] = data
+        logging.info('open %s: handle %d, %d bytes',
+                     path, self.handle, len(data))
+        self.send(pack('>iI', self.handle, len(data)))
+
+    def do_read(self, handle, offset, length):
+        if handle not in self.files:
+            self.send(pack('>i', EBADF))
+            return
+        if length > CHUNK:
+            self.send(pack('>i', EINVAL))
+            return
+        data = self.files[handle][offset:offset + length]
+        logging.debug('read %d: %d bytes at %d', handle, len(data), offset)
+        self.send(pack('>i', len(data)) + data + pack('>H', checksum(data)))
+
+    def do_close(self, handle):
+        if self.files.pop(handle, None) is None:
+            self.send(pack('>i', EBADF))
+            return
+        logging.debug('close %d', handle)
+        self.send(pack('>i', 0))
+
+    def serve(self):
+        while True:
+            # resynchronize on garbage that may have been sent to serial port
+            if self.recv(1) != b'F':
+                continue
+            cmd, length, handle, offset = unpack('>cHiI', self.recv(11))
+            if cmd == b'O':
+                name = self.recv(length).rstrip(b'\0').decode('ascii')
+                self.do_open(name)
+            elif cmd == b'R':
+                self.do_read(handle, offset, length)
+            elif cmd == b'C':
+                self.do_close(handle)
+            else:
+                logging.warning('unknown command %r', cmd)
+
+
+def connect(port):
+    # The emulator opens the server some time after it has started.
+    while True:
+        try:
+            return socket.create_connection(('localhost', port))
+        except ConnectionRefusedError:
+            time.sleep(0.1)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Serves files to Amiga over serial port.')
+    parser.add_argument('-p', '--port', type=int, default=8000,
+                        help='TCP port of emulated serial port.')
+    parser.add_argument('-v', '--verbose', action='store_true',
+                        help='Report each transfer.')
+    parser.add_argument('dirs', metavar='DIR', type=str, nargs='*',
+                        default=['.', 'data'],
+                        help='Directories searched for requested files.')
+    args = parser.parse_args()
+
+    logging.basicConfig(level=[logging.INFO, logging.DEBUG][args.verbose],
+                        format='%(levelname)s: %(message)s')
+
+    for d in args.dirs:
+        if not os.path.isdir(d):
+            raise SystemExit('%s: directory does not exist!' % d)
+
+    while True:
+        logging.info('waiting for connection on port %d', args.port)
+        with connect(args.port) as sock:
+            try:
+                RemoteFS(sock, args.dirs).serve()
+            except EOFError:
+                logging.info('connection closed')